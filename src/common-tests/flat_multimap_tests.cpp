@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "common/flat_multimap.h"
+#include "common/xorshift_prng.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+TEST(FlatMultiMap, InsertRemove)
+{
+  FlatMultiMap<int> map;
+  const FlatMultiMap<int>::Handle a = map.Insert(0x80010000, 1);
+  const FlatMultiMap<int>::Handle b = map.Insert(0x80010000, 2);
+  const FlatMultiMap<int>::Handle c = map.Insert(0x80020000, 3);
+  ASSERT_EQ(map.GetSize(), 3u);
+  ASSERT_EQ(map.Count(0x80010000), 2u);
+  ASSERT_EQ(map.Count(0x80020000), 1u);
+  ASSERT_EQ(map.Count(0x80030000), 0u);
+
+  std::vector<int> values;
+  map.ForEach(0x80010000, [&values](int value) { values.push_back(value); });
+  ASSERT_EQ(values, (std::vector<int>{2, 1}));
+
+  map.Remove(b);
+  values.clear();
+  map.ForEach(0x80010000, [&values](int value) { values.push_back(value); });
+  ASSERT_EQ(values, (std::vector<int>{1}));
+
+  map.Remove(a);
+  map.Remove(c);
+  ASSERT_TRUE(map.IsEmpty());
+  ASSERT_EQ(map.Count(0x80010000), 0u);
+
+  // handles should be recycled
+  const FlatMultiMap<int>::Handle d = map.Insert(0, 4);
+  ASSERT_TRUE(d == a || d == b || d == c);
+  ASSERT_EQ(map.Count(0), 1u);
+}
+
+TEST(FlatMultiMap, RemoveFromMiddleOfChain)
+{
+  FlatMultiMap<u32> map;
+  std::vector<FlatMultiMap<u32>::Handle> handles;
+  for (u32 i = 0; i < 5; i++)
+    handles.push_back(map.Insert(0x1000, i));
+
+  map.Remove(handles[2]);
+  map.Remove(handles[4]);
+  map.Remove(handles[0]);
+
+  std::vector<u32> values;
+  map.ForEach(0x1000, [&values](u32 value) { values.push_back(value); });
+  ASSERT_EQ(values, (std::vector<u32>{3, 1}));
+}
+
+TEST(FlatMultiMap, Rehash)
+{
+  FlatMultiMap<u32> map;
+  std::vector<FlatMultiMap<u32>::Handle> handles;
+  for (u32 i = 0; i < 10000; i++)
+    handles.push_back(map.Insert(i * 4, i));
+
+  ASSERT_EQ(map.GetSize(), 10000u);
+  for (u32 i = 0; i < 10000; i += 2)
+    map.Remove(handles[i]);
+
+  // forces a rehash, which should drop the keys without values
+  for (u32 i = 0; i < 10000; i++)
+    map.Insert(0x100000 + i * 4, i);
+
+  for (u32 i = 0; i < 10000; i++)
+  {
+    ASSERT_EQ(map.Count(i * 4), (i & 1u));
+    ASSERT_EQ(map.Count(0x100000 + i * 4), 1u);
+  }
+
+  map.Clear();
+  ASSERT_TRUE(map.IsEmpty());
+  ASSERT_EQ(map.Count(0x100000), 0u);
+}
+
+TEST(FlatMultiMap, InvalidationStormMatchesStdMultiMap)
+{
+  // Shaped like the code cache: blocks of 16 instructions with two exit links, invalidated a 4KB page at a time.
+  static constexpr u32 BASE_PC = 0x80010000;
+  static constexpr u32 NUM_BLOCKS = 4096;
+  static constexpr u32 BLOCK_SIZE = 64;
+  static constexpr u32 BLOCKS_PER_PAGE = 4096 / BLOCK_SIZE;
+  static constexpr u32 NUM_PAGES = NUM_BLOCKS / BLOCKS_PER_PAGE;
+  static constexpr u32 ITERATIONS = 1024;
+
+  using StdMap = std::unordered_multimap<u32, u32>;
+  StdMap std_map;
+  FlatMultiMap<u32> flat_map;
+  std::vector<std::array<std::pair<StdMap::iterator, FlatMultiMap<u32>::Handle>, 2>> exit_links(NUM_BLOCKS);
+
+  XorShift128PlusPlus rng(0x12345678);
+  const auto link = [&](u32 block, u32 exit, u32 target) {
+    const u32 pc = BASE_PC + block * BLOCK_SIZE;
+    exit_links[block][exit] = std::make_pair(std_map.emplace(target, pc), flat_map.Insert(target, pc));
+  };
+  const auto link_block = [&](u32 block) {
+    link(block, 0, BASE_PC + (block + 1) * BLOCK_SIZE);
+    link(block, 1, BASE_PC + static_cast<u32>(rng.Next() % NUM_BLOCKS) * BLOCK_SIZE);
+  };
+  const auto check_backlinks = [&](u32 pc) {
+    std::vector<u32> expected;
+    const auto range = std_map.equal_range(pc);
+    for (auto it = range.first; it != range.second; ++it)
+      expected.push_back(it->second);
+
+    std::vector<u32> actual;
+    flat_map.ForEach(pc, [&actual](u32 value) { actual.push_back(value); });
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(expected, actual) << "backlinks to " << pc;
+  };
+
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+    link_block(i);
+
+  for (u32 iter = 0; iter < ITERATIONS; iter++)
+  {
+    const u32 first_block = static_cast<u32>(rng.Next() % NUM_PAGES) * BLOCKS_PER_PAGE;
+    for (u32 i = first_block; i < (first_block + BLOCKS_PER_PAGE); i++)
+    {
+      // invalidate: backlink to the compiler, then unlink the exits and relink them when recompiled
+      const u32 pc = BASE_PC + i * BLOCK_SIZE;
+      check_backlinks(pc);
+      for (const auto& [it, handle] : exit_links[i])
+      {
+        std_map.erase(it);
+        flat_map.Remove(handle);
+      }
+
+      link_block(i);
+      check_backlinks(pc);
+    }
+
+    ASSERT_EQ(std_map.size(), flat_map.GetSize());
+  }
+
+  for (u32 i = 0; i <= NUM_BLOCKS; i++)
+    check_backlinks(BASE_PC + i * BLOCK_SIZE);
+}
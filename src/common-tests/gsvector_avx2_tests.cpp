@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "common/gsvector.h"
+#include "common/xorshift_prng.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#if defined(CPU_ARCH_SSE) && !defined(CPU_ARCH_AVX2)
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Operations used by the software rasterizer's vector path, which should give the same result as the 128-bit version
+// on each half, so that the AVX2 rasterizer draws exactly the same pixels as the SSE rasterizer. Inputs are limited to
+// what the rasterizer passes in, the SSE2 fallbacks assume blend8() masks are comparison results, and pu32() is only
+// used on values which already fit in 16 bits.
+#define DEFINE_RASTERIZER_OPS(V)                                                                                       \
+  static constexpr u32 NUM_RASTERIZER_OPS = 15;                                                                        \
+  static void RunRasterizerOps(const u32* a_ptr, const u32* b_ptr, u32* out, u32 stride)                               \
+  {                                                                                                                    \
+    const V a = V::load<false>(a_ptr);                                                                                 \
+    const V b = V::load<false>(b_ptr);                                                                                 \
+    const V results[NUM_RASTERIZER_OPS] = {a.add32(b),                                                                 \
+                                           a.sub32(b),                                                                 \
+                                           a.add16(b),                                                                 \
+                                           a.sra16<3>(),                                                               \
+                                           a.sra16<15>(),                                                              \
+                                           a.srl32<5>(),                                                               \
+                                           a.sll32<10>(),                                                              \
+                                           a.min_u16(b),                                                               \
+                                           a.max_s16(b),                                                               \
+                                           a.lt32(b),                                                                  \
+                                           a.gt32(b) | a.eq32(b),                                                      \
+                                           a.andnot(b),                                                                \
+                                           a.blend16<0xaa>(b),                                                         \
+                                           a.blend8(b, a.lt32(b)),                                                     \
+                                           a.srl32<16>().pu32(b.srl32<16>())};                                         \
+    for (u32 i = 0; i < NUM_RASTERIZER_OPS; i++)                                                                       \
+      V::store<false>(&out[i * stride], results[i]);                                                                   \
+  }
+
+namespace {
+DEFINE_RASTERIZER_OPS(GSVector4i)
+}
+
+// Same as the software rasterizer, see gpu_sw_rasterizer_avx2.cpp.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace AVX2 {
+
+#ifndef CPU_ARCH_AVX
+#define CPU_ARCH_AVX 1
+#endif
+#define CPU_ARCH_AVX2 1
+#define GSVECTOR_INCLUDE_FOR_ISA 1
+#include "common/gsvector_sse.h"
+#undef GSVECTOR_INCLUDE_FOR_ISA
+
+namespace {
+DEFINE_RASTERIZER_OPS(GSVector8i)
+
+static void ShiftRightVariable(const u32* a_ptr, const u32* b_ptr, u32* out)
+{
+  GSVector8i::store<false>(out, GSVector8i::load<false>(a_ptr).srlv32(GSVector8i::load<false>(b_ptr)));
+}
+} // namespace
+
+} // namespace AVX2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#undef DEFINE_RASTERIZER_OPS
+
+static bool HostSupportsAVX2()
+{
+#ifdef _MSC_VER
+  int regs[4];
+  __cpuidex(regs, 7, 0);
+  return ((regs[1] & (1 << 5)) != 0);
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+TEST(GSVectorAVX2Test, RasterizerOpsMatch128Bit)
+{
+  if (!HostSupportsAVX2())
+    GTEST_SKIP() << "Host does not support AVX2";
+
+  XorShift128PlusPlus rng(0x12345678);
+  for (u32 iter = 0; iter < 10000; iter++)
+  {
+    u32 a[8], b[8];
+    for (u32 i = 0; i < 8; i++)
+    {
+      // mix in some equal values, otherwise the comparisons are never equal
+      a[i] = static_cast<u32>(rng.Next());
+      b[i] = ((rng.Next() & 3) == 0) ? a[i] : static_cast<u32>(rng.Next());
+    }
+
+    u32 expected[NUM_RASTERIZER_OPS * 8];
+    RunRasterizerOps(&a[0], &b[0], &expected[0], 8);
+    RunRasterizerOps(&a[4], &b[4], &expected[4], 8);
+
+    u32 actual[AVX2::NUM_RASTERIZER_OPS * 8];
+    AVX2::RunRasterizerOps(a, b, actual, 8);
+    for (u32 i = 0; i < NUM_RASTERIZER_OPS * 8; i++)
+      ASSERT_EQ(expected[i], actual[i]) << "op " << (i / 8) << " element " << (i % 8);
+  }
+}
+
+TEST(GSVectorAVX2Test, ShiftRightVariable)
+{
+  if (!HostSupportsAVX2())
+    GTEST_SKIP() << "Host does not support AVX2";
+
+  XorShift128PlusPlus rng(0x87654321);
+  for (u32 iter = 0; iter < 10000; iter++)
+  {
+    u32 a[8], b[8], actual[8];
+    for (u32 i = 0; i < 8; i++)
+    {
+      a[i] = static_cast<u32>(rng.Next());
+      b[i] = static_cast<u32>(rng.Next() % 32);
+    }
+
+    AVX2::ShiftRightVariable(a, b, actual);
+    for (u32 i = 0; i < 8; i++)
+      ASSERT_EQ(a[i] >> b[i], actual[i]);
+  }
+}
+
+#endif // defined(CPU_ARCH_SSE) && !defined(CPU_ARCH_AVX2)
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "types.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+/// Multimap from u32 keys to values, using open addressing for the keys and a pooled node array for the values.
+/// Insert() returns a handle which can be used to remove that value in constant time, without a lookup.
+/// Keys are kept once they have been inserted, until the table is resized or cleared, since they tend to be reused.
+template<typename T>
+class FlatMultiMap
+{
+public:
+  using Handle = u32;
+  static constexpr Handle INVALID_HANDLE = 0xFFFFFFFFu;
+
+  FlatMultiMap() { AllocateSlots(INITIAL_SLOT_COUNT); }
+
+  ALWAYS_INLINE u32 GetSize() const { return m_size; }
+  ALWAYS_INLINE bool IsEmpty() const { return (m_size == 0); }
+
+  Handle Insert(u32 key, T value)
+  {
+    if ((m_used_slots + 1) > (static_cast<u32>(m_slots.size()) / 4) * 3)
+      Rehash();
+
+    Handle handle;
+    if (m_free_head != INVALID_HANDLE)
+    {
+      handle = m_free_head;
+      m_free_head = m_nodes[handle].next;
+    }
+    else
+    {
+      handle = static_cast<Handle>(m_nodes.size());
+      m_nodes.emplace_back();
+    }
+
+    Slot& slot = FindOrInsertSlot(key);
+    Node& node = m_nodes[handle];
+    node.value = std::move(value);
+    node.key = key;
+    node.prev = INVALID_HANDLE;
+    node.next = (slot.head != NO_NODES) ? slot.head : INVALID_HANDLE;
+    if (node.next != INVALID_HANDLE)
+      m_nodes[node.next].prev = handle;
+
+    slot.head = handle;
+    m_size++;
+    return handle;
+  }
+
+  void Remove(Handle handle)
+  {
+    Node& node = m_nodes[handle];
+    if (node.prev != INVALID_HANDLE)
+      m_nodes[node.prev].next = node.next;
+    else
+      FindSlot(node.key)->head = (node.next != INVALID_HANDLE) ? node.next : NO_NODES;
+
+    if (node.next != INVALID_HANDLE)
+      m_nodes[node.next].prev = node.prev;
+
+    node.value = T();
+    node.prev = INVALID_HANDLE;
+    node.next = m_free_head;
+    m_free_head = handle;
+    m_size--;
+  }
+
+  /// Calls func with each value for the key, most recently inserted first.
+  template<typename F>
+  void ForEach(u32 key, const F& func) const
+  {
+    const Slot* slot = FindSlot(key);
+    if (!slot || slot->head == NO_NODES)
+      return;
+
+    for (Handle handle = slot->head; handle != INVALID_HANDLE; handle = m_nodes[handle].next)
+      func(m_nodes[handle].value);
+  }
+
+  u32 Count(u32 key) const
+  {
+    u32 count = 0;
+    ForEach(key, [&count](const T&) { count++; });
+    return count;
+  }
+
+  void Clear()
+  {
+    AllocateSlots(INITIAL_SLOT_COUNT);
+    m_nodes.clear();
+    m_free_head = INVALID_HANDLE;
+    m_size = 0;
+  }
+
+private:
+  static constexpr u32 INITIAL_SLOT_COUNT = 1024;
+
+  // head values for slots, with real node handles below these
+  static constexpr u32 EMPTY_SLOT = 0xFFFFFFFFu;
+  static constexpr u32 NO_NODES = 0xFFFFFFFEu;
+
+  struct Slot
+  {
+    u32 key;
+    u32 head;
+  };
+
+  struct Node
+  {
+    T value;
+    u32 key;
+    Handle prev;
+    Handle next;
+  };
+
+  ALWAYS_INLINE u32 GetSlotIndex(u32 key) const { return (key * 0x9E3779B1u) >> m_hash_shift; }
+
+  const Slot* FindSlot(u32 key) const
+  {
+    const u32 mask = static_cast<u32>(m_slots.size()) - 1;
+    for (u32 index = GetSlotIndex(key);; index = (index + 1) & mask)
+    {
+      const Slot& slot = m_slots[index];
+      if (slot.head == EMPTY_SLOT)
+        return nullptr;
+      else if (slot.key == key)
+        return &slot;
+    }
+  }
+
+  Slot* FindSlot(u32 key) { return const_cast<Slot*>(std::as_const(*this).FindSlot(key)); }
+
+  Slot& FindOrInsertSlot(u32 key)
+  {
+    const u32 mask = static_cast<u32>(m_slots.size()) - 1;
+    for (u32 index = GetSlotIndex(key);; index = (index + 1) & mask)
+    {
+      Slot& slot = m_slots[index];
+      if (slot.head == EMPTY_SLOT)
+      {
+        slot.key = key;
+        slot.head = NO_NODES;
+        m_used_slots++;
+        return slot;
+      }
+      else if (slot.key == key)
+      {
+        return slot;
+      }
+    }
+  }
+
+  void AllocateSlots(u32 count)
+  {
+    m_slots.assign(count, Slot{0, EMPTY_SLOT});
+    m_hash_shift = 32 - static_cast<u32>(std::countr_zero(count));
+    m_used_slots = 0;
+  }
+
+  void Rehash()
+  {
+    // drop keys which no longer have any values, and only grow if it's still over half full
+    std::vector<Slot> old_slots = std::move(m_slots);
+    u32 live_slots = 0;
+    for (const Slot& slot : old_slots)
+      live_slots += static_cast<u32>(slot.head < NO_NODES);
+
+    AllocateSlots(std::max(INITIAL_SLOT_COUNT, std::bit_ceil((live_slots + 1) * 2)));
+    for (const Slot& slot : old_slots)
+    {
+      if (slot.head < NO_NODES)
+        FindOrInsertSlot(slot.key).head = slot.head;
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  std::vector<Node> m_nodes;
+  Handle m_free_head = INVALID_HANDLE;
+  u32 m_hash_shift = 0;
+  u32 m_used_slots = 0;
+  u32 m_size = 0;
+};
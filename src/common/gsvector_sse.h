@@ -4,8 +4,15 @@
 // Lightweight wrapper over native SIMD types for cross-platform vector code.
 // Rewritten and NEON+No-SIMD variants added for DuckStation.
 //
+// Code which is compiled for a different ISA to the rest of the program can include this header a second time inside
+// its own namespace, by defining GSVECTOR_INCLUDE_FOR_ISA, to get a separate copy of the classes. Sharing the global
+// classes is not safe, because the linker is free to pick either ISA's copy of an inline function for everyone.
+//
 
-#pragma once
+#if !defined(COMMON_GSVECTOR_SSE_H) || defined(GSVECTOR_INCLUDE_FOR_ISA)
+#ifndef GSVECTOR_INCLUDE_FOR_ISA
+#define COMMON_GSVECTOR_SSE_H
+#endif
 
 #include "common/intrin.h"
 #include "common/types.h"
@@ -2984,6 +2991,12 @@ public:
                                 _mm256_loadu_si256(static_cast<const __m256i*>(p)));
   }
 
+  template<s32 scale>
+  ALWAYS_INLINE static GSVector8i gather32(const void* base, const GSVector8i& offsets)
+  {
+    return GSVector8i(_mm256_i32gather_epi32(static_cast<const int*>(base), offsets.m, scale));
+  }
+
   ALWAYS_INLINE static void storent(void* p, const GSVector8i& v)
   {
     _mm256_stream_si256(static_cast<__m256i*>(p), v.m);
@@ -3061,3 +3074,5 @@ public:
 };
 
 #endif
+
+#endif // !defined(COMMON_GSVECTOR_SSE_H) || defined(GSVECTOR_INCLUDE_FOR_ISA)
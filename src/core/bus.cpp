@@ -20,6 +20,7 @@
 #include "sio.h"
 #include "spu.h"
 #include "system.h"
+#include "system_private.h"
 #include "timers.h"
 #include "timing_event.h"
 
@@ -38,6 +39,12 @@
 #include "common/path.h"
 #include "common/string_util.h"
 
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <cstdio>
 #include <tuple>
 #include <utility>
@@ -123,6 +130,7 @@ static void* s_shmem_handle = nullptr;
 static std::string s_shmem_name;
 
 std::bitset<RAM_8MB_CODE_PAGE_COUNT> g_ram_code_bits{};
+std::array<u8, RAM_DIRTY_PAGE_COUNT> g_ram_dirty_pages{};
 u8* g_ram = nullptr;
 u8* g_unprotected_ram = nullptr;
 u32 g_ram_size = 0;
@@ -152,6 +160,18 @@ static u8** s_fastmem_lut = nullptr;
 
 static bool s_kernel_initialize_hook_run = false;
 
+// Generation each RAM page was last modified in. Memory save states record the generation they were taken at,
+// any page with an older or equal generation is known to match the state's copy and does not need to be copied.
+static std::array<u64, RAM_DIRTY_PAGE_COUNT> s_ram_page_generations = {};
+static u64 s_ram_generation = 1;
+static MemorySaveStateSnapshotMode s_ram_snapshot_mode = MemorySaveStateSnapshotMode::Full;
+
+#ifdef __linux__
+// Soft-dirty bits are set by the kernel on the first write to each page after clearing, through any mapping.
+static int s_pagemap_fd = -1;
+static int s_clear_refs_fd = -1;
+#endif
+
 static bool AllocateMemoryMap(bool export_shared_memory, Error* error);
 static void ReleaseMemoryMap();
 static void SetRAMSize(bool enable_8mb_ram);
@@ -165,6 +185,18 @@ static u8* GetLUTFastmemPointer(u32 address, u8* ram_ptr);
 
 static void SetRAMPageWritable(u32 page_index, bool writable);
 
+static bool DoState(StateWrapper& sw, System::MemorySaveState* mss);
+static void DoMemoryStateRAM(StateWrapper& sw, System::MemorySaveState& mss);
+static void FlushRAMDirtyPages();
+
+#ifdef __linux__
+static bool OpenSoftDirtyTracking(Error* error);
+static void CloseSoftDirtyTracking();
+static bool ClearSoftDirtyBits();
+static bool ReadSoftDirtyPages(const u8* ptr, size_t size);
+static void ReadSoftDirtyPages();
+#endif
+
 static void KernelInitializedHook();
 static bool SideloadEXE(const std::string& path, Error* error);
 static bool InjectCPE(std::span<const u8> buffer, bool set_pc, Error* error);
@@ -410,6 +442,7 @@ void Bus::Shutdown()
 void Bus::Reset()
 {
   std::memset(g_ram, 0, g_ram_size);
+  MarkAllRAMPagesDirty();
   s_MEMCTRL.exp1_base = 0x1F000000;
   s_MEMCTRL.exp2_base = 0x1F802000;
   s_MEMCTRL.exp1_delay_size.bits = 0x0013243F;
@@ -432,14 +465,26 @@ void Bus::Reset()
 }
 
 bool Bus::DoState(StateWrapper& sw)
+{
+  return DoState(sw, nullptr);
+}
+
+bool Bus::DoMemoryState(StateWrapper& sw, System::MemorySaveState& mss)
+{
+  return DoState(sw, &mss);
+}
+
+bool Bus::DoState(StateWrapper& sw, System::MemorySaveState* mss)
 {
   u32 ram_size = g_ram_size;
   sw.DoEx(&ram_size, 52, static_cast<u32>(RAM_2MB_SIZE));
   if (ram_size != g_ram_size)
   {
     const bool using_8mb_ram = (ram_size == RAM_8MB_SIZE);
+    CPU::CodeCache::InvalidateAllRAMBlocks();
     SetRAMSize(using_8mb_ram);
     RemapFastmemViews();
+    MarkAllRAMPagesDirty();
   }
 
   sw.Do(&g_exp1_access_time);
@@ -447,7 +492,17 @@ bool Bus::DoState(StateWrapper& sw)
   sw.Do(&g_bios_access_time);
   sw.Do(&g_cdrom_access_time);
   sw.Do(&g_spu_access_time);
-  sw.DoBytes(g_ram, g_ram_size);
+
+  if (mss)
+  {
+    DoMemoryStateRAM(sw, *mss);
+  }
+  else
+  {
+    sw.DoBytes(g_ram, g_ram_size);
+    if (sw.IsReading())
+      MarkAllRAMPagesDirty();
+  }
 
   if (sw.GetVersion() < 58) [[unlikely]]
   {
@@ -469,6 +524,239 @@ bool Bus::DoState(StateWrapper& sw)
   return !sw.HasError();
 }
 
+void Bus::DoMemoryStateRAM(StateWrapper& sw, System::MemorySaveState& mss)
+{
+  const size_t offset = sw.GetPosition();
+  const std::span<u8> data = sw.GetDeferredBytes(g_ram_size);
+  if (data.empty()) [[unlikely]]
+    return;
+
+  FlushRAMDirtyPages();
+
+  // Slot contents can only be trusted if the state layout is unchanged, and everything written to RAM was tracked.
+  const bool skip_unchanged = (s_ram_snapshot_mode != MemorySaveStateSnapshotMode::Full && mss.ram_generation != 0 &&
+                               mss.ram_offset == offset && mss.ram_size == g_ram_size);
+  const u32 num_pages = g_ram_size >> RAM_DIRTY_PAGE_SHIFT;
+  if (sw.IsReading())
+  {
+    for (u32 i = 0; i < num_pages; i++)
+    {
+      if (skip_unchanged && s_ram_page_generations[i] <= mss.ram_generation)
+        continue;
+
+      // Only throw away blocks if the code page actually differs, rewinding/running ahead usually doesn't touch code.
+      // Protected pages can't be written to until their blocks are invalidated, so skip the copy if it's unchanged.
+      u8* const ram_page = &g_ram[i << RAM_DIRTY_PAGE_SHIFT];
+      const u8* const state_page = &data[i << RAM_DIRTY_PAGE_SHIFT];
+      const u32 code_page_index = GetRAMCodePageIndex(i << RAM_DIRTY_PAGE_SHIFT);
+      if (IsRAMCodePage(code_page_index))
+      {
+        if (std::memcmp(ram_page, state_page, RAM_DIRTY_PAGE_SIZE) == 0)
+        {
+          s_ram_page_generations[i] = s_ram_generation;
+          continue;
+        }
+
+        CPU::CodeCache::InvalidateBlocksWithPageIndexForStateLoad(code_page_index);
+      }
+
+      // Page now matches this state, but not necessarily any of the others.
+      std::memcpy(ram_page, state_page, RAM_DIRTY_PAGE_SIZE);
+      s_ram_page_generations[i] = s_ram_generation;
+    }
+  }
+  else
+  {
+    for (u32 i = 0; i < num_pages; i++)
+    {
+      if (skip_unchanged && s_ram_page_generations[i] <= mss.ram_generation)
+        continue;
+
+      std::memcpy(&data[i << RAM_DIRTY_PAGE_SHIFT], &g_ram[i << RAM_DIRTY_PAGE_SHIFT], RAM_DIRTY_PAGE_SIZE);
+    }
+
+    mss.ram_generation = s_ram_generation;
+    mss.ram_offset = offset;
+    mss.ram_size = g_ram_size;
+  }
+
+  s_ram_generation++;
+}
+
+void Bus::FlushRAMDirtyPages()
+{
+#ifdef __linux__
+  if (s_ram_snapshot_mode == MemorySaveStateSnapshotMode::SoftDirty)
+    ReadSoftDirtyPages();
+#endif
+
+  // Writes to mirrors of 2MB RAM land in the upper pages, fold them back down.
+  const u32 page_mask = (g_ram_size >> RAM_DIRTY_PAGE_SHIFT) - 1;
+  for (u32 i = 0; i < RAM_DIRTY_PAGE_COUNT; i++)
+  {
+    if (!g_ram_dirty_pages[i])
+      continue;
+
+    g_ram_dirty_pages[i] = 0;
+    s_ram_page_generations[i & page_mask] = s_ram_generation;
+  }
+}
+
+void Bus::MarkRAMRangeDirty(PhysicalMemoryAddress start_address, u32 size)
+{
+  if (size == 0)
+    return;
+
+  const u32 page_mask = (g_ram_size >> RAM_DIRTY_PAGE_SHIFT) - 1;
+  const u32 start_page = (start_address & g_ram_mask) >> RAM_DIRTY_PAGE_SHIFT;
+  const u32 num_pages = std::min(
+    ((start_address & (RAM_DIRTY_PAGE_SIZE - 1)) + size + (RAM_DIRTY_PAGE_SIZE - 1)) >> RAM_DIRTY_PAGE_SHIFT,
+    page_mask + 1);
+  for (u32 i = 0; i < num_pages; i++)
+    g_ram_dirty_pages[(start_page + i) & page_mask] = 1;
+}
+
+void Bus::MarkAllRAMPagesDirty()
+{
+  g_ram_dirty_pages.fill(1);
+}
+
+bool Bus::IsRAMDirtyPageTrackingEnabled()
+{
+  return (s_ram_snapshot_mode == MemorySaveStateSnapshotMode::WriteTracking);
+}
+
+bool Bus::SetRAMSnapshotMode(MemorySaveStateSnapshotMode mode)
+{
+  if (s_ram_snapshot_mode == mode)
+    return false;
+
+#ifdef __linux__
+  if (s_ram_snapshot_mode == MemorySaveStateSnapshotMode::SoftDirty)
+    CloseSoftDirtyTracking();
+
+  if (mode == MemorySaveStateSnapshotMode::SoftDirty)
+  {
+    Error error;
+    if (!OpenSoftDirtyTracking(&error))
+    {
+      WARNING_LOG("Soft-dirty page tracking is unavailable, using write tracking: {}", error.GetDescription());
+      mode = MemorySaveStateSnapshotMode::WriteTracking;
+    }
+  }
+#else
+  if (mode == MemorySaveStateSnapshotMode::SoftDirty)
+  {
+    WARNING_LOG("Soft-dirty page tracking is only available on Linux, using write tracking.");
+    mode = MemorySaveStateSnapshotMode::WriteTracking;
+  }
+#endif
+
+  // Writes from recompiled code may not have been tracked up until now.
+  const bool flush_code = (IsRAMDirtyPageTrackingEnabled() != (mode == MemorySaveStateSnapshotMode::WriteTracking));
+  s_ram_snapshot_mode = mode;
+  MarkAllRAMPagesDirty();
+  return flush_code;
+}
+
+#ifdef __linux__
+
+bool Bus::OpenSoftDirtyTracking(Error* error)
+{
+  s_pagemap_fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+  s_clear_refs_fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+  if (s_pagemap_fd < 0 || s_clear_refs_fd < 0)
+  {
+    Error::SetErrno(error, "open() failed: ", errno);
+    CloseSoftDirtyTracking();
+    return false;
+  }
+
+  // Kernels without CONFIG_MEM_SOFT_DIRTY accept the write, but never set the bit. Check it actually works.
+  if (!ClearSoftDirtyBits())
+  {
+    Error::SetErrno(error, "Failed to clear soft-dirty bits: ", errno);
+    CloseSoftDirtyTracking();
+    return false;
+  }
+
+  g_ram_dirty_pages.fill(0);
+  volatile u8* const test_ptr = g_unprotected_ram;
+  *test_ptr = *test_ptr;
+  if (!ReadSoftDirtyPages(g_unprotected_ram, HOST_PAGE_SIZE) || !g_ram_dirty_pages[0])
+  {
+    Error::SetStringView(error, "Kernel does not support soft-dirty bits.");
+    CloseSoftDirtyTracking();
+    return false;
+  }
+
+  INFO_LOG("Using soft-dirty bits for memory save state snapshots.");
+  return true;
+}
+
+void Bus::CloseSoftDirtyTracking()
+{
+  if (s_clear_refs_fd >= 0)
+  {
+    close(s_clear_refs_fd);
+    s_clear_refs_fd = -1;
+  }
+  if (s_pagemap_fd >= 0)
+  {
+    close(s_pagemap_fd);
+    s_pagemap_fd = -1;
+  }
+}
+
+bool Bus::ClearSoftDirtyBits()
+{
+  // Applies to the whole process, there's no way to limit it to a range.
+  static constexpr char CLEAR_SOFT_DIRTY = '4';
+  return (pwrite(s_clear_refs_fd, &CLEAR_SOFT_DIRTY, sizeof(CLEAR_SOFT_DIRTY), 0) == sizeof(CLEAR_SOFT_DIRTY));
+}
+
+bool Bus::ReadSoftDirtyPages(const u8* ptr, size_t size)
+{
+  static constexpr u64 PAGEMAP_SOFT_DIRTY_BIT = UINT64_C(1) << 55;
+
+  // Mapping always starts at the beginning of RAM.
+  std::array<u64, RAM_8MB_SIZE / MIN_HOST_PAGE_SIZE> entries;
+  const size_t num_entries = size >> HOST_PAGE_SHIFT;
+  const off_t offset = static_cast<off_t>((reinterpret_cast<uintptr_t>(ptr) >> HOST_PAGE_SHIFT) * sizeof(u64));
+  DebugAssert(num_entries <= entries.size());
+  if (pread(s_pagemap_fd, entries.data(), num_entries * sizeof(u64), offset) !=
+      static_cast<ssize_t>(num_entries * sizeof(u64)))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < num_entries; i++)
+  {
+    if (entries[i] & PAGEMAP_SOFT_DIRTY_BIT)
+      MarkRAMRangeDirty(static_cast<u32>(i << HOST_PAGE_SHIFT), HOST_PAGE_SIZE);
+  }
+
+  return true;
+}
+
+void Bus::ReadSoftDirtyPages()
+{
+  // Every view of RAM has its own page table entries, so all of them need to be checked.
+  bool result = ReadSoftDirtyPages(g_ram, g_ram_size) && ReadSoftDirtyPages(g_unprotected_ram, g_ram_size);
+#ifdef ENABLE_MMAP_FASTMEM
+  for (const auto& [view_ptr, view_size] : s_fastmem_ram_views)
+    result = result && ReadSoftDirtyPages(view_ptr, view_size);
+#endif
+
+  if (!result || !ClearSoftDirtyBits()) [[unlikely]]
+  {
+    ERROR_LOG("Failed to read soft-dirty bits, copying all pages: errno {}", errno);
+    MarkAllRAMPagesDirty();
+  }
+}
+
+#endif
+
 std::tuple<TickCount, TickCount, TickCount> Bus::CalculateMemoryTiming(MEMDELAY mem_delay, COMDELAY common_delay)
 {
   // from nocash spec
@@ -1373,6 +1661,8 @@ void Bus::RAMWriteHandler(VirtualMemoryAddress address, u32 value)
 {
   const u32 offset = address & g_ram_mask;
 
+  MarkRAMPageDirty(offset);
+
   if constexpr (size == MemoryAccessSize::Byte)
   {
     g_ram[offset] = Truncate8(value);
@@ -2112,6 +2402,61 @@ void Bus::HardwareWriteHandler(VirtualMemoryAddress address, u32 value)
   return table[table_index](address, value);
 }
 
+namespace Bus::HWHandlers {
+static bool IsHardwareRegisterAddress(VirtualMemoryAddress address)
+{
+  // Only mapped in KUSEG, KSEG0 and KSEG1.
+  const u32 segment = address >> 29;
+  return ((segment == 0 || segment == 4 || segment == 5) && (address & 0x1FFFF000u) == HW_BASE);
+}
+
+template<MemoryAccessType type, MemoryAccessSize size,
+         typename RT = std::conditional_t<type == MemoryAccessType::Read, MemoryReadHandler, MemoryWriteHandler>>
+static RT GetHardwareRegisterHandler(VirtualMemoryAddress address)
+{
+  static constexpr const auto table = GetHardwareRegisterHandlerTable<type, size>();
+  const RT handler = table[(address >> 4) & 0xFFu];
+  if constexpr (type == MemoryAccessType::Read)
+    return (handler != UnmappedReadHandler<size>) ? handler : nullptr;
+  else
+    return (handler != UnmappedWriteHandler<size>) ? handler : nullptr;
+}
+} // namespace Bus::HWHandlers
+
+Bus::MemoryReadHandler Bus::GetHardwareRegisterReadHandler(VirtualMemoryAddress address, MemoryAccessSize size)
+{
+  if (!HWHandlers::IsHardwareRegisterAddress(address))
+    return nullptr;
+
+  switch (size)
+  {
+    case MemoryAccessSize::Byte:
+      return HWHandlers::GetHardwareRegisterHandler<MemoryAccessType::Read, MemoryAccessSize::Byte>(address);
+    case MemoryAccessSize::HalfWord:
+      return HWHandlers::GetHardwareRegisterHandler<MemoryAccessType::Read, MemoryAccessSize::HalfWord>(address);
+    case MemoryAccessSize::Word:
+    default:
+      return HWHandlers::GetHardwareRegisterHandler<MemoryAccessType::Read, MemoryAccessSize::Word>(address);
+  }
+}
+
+Bus::MemoryWriteHandler Bus::GetHardwareRegisterWriteHandler(VirtualMemoryAddress address, MemoryAccessSize size)
+{
+  if (!HWHandlers::IsHardwareRegisterAddress(address))
+    return nullptr;
+
+  switch (size)
+  {
+    case MemoryAccessSize::Byte:
+      return HWHandlers::GetHardwareRegisterHandler<MemoryAccessType::Write, MemoryAccessSize::Byte>(address);
+    case MemoryAccessSize::HalfWord:
+      return HWHandlers::GetHardwareRegisterHandler<MemoryAccessType::Write, MemoryAccessSize::HalfWord>(address);
+    case MemoryAccessSize::Word:
+    default:
+      return HWHandlers::GetHardwareRegisterHandler<MemoryAccessType::Write, MemoryAccessSize::Word>(address);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 static constexpr u32 KUSEG = 0;
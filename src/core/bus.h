@@ -15,6 +15,10 @@ class Error;
 
 class StateWrapper;
 
+namespace System {
+struct MemorySaveState;
+}
+
 namespace Bus {
 
 enum : u32
@@ -105,6 +109,10 @@ enum : u32
   FASTMEM_LUT_PAGE_SHIFT = 12,
   FASTMEM_LUT_SIZE = 0x100000,              // 0x100000000 >> 12
   FASTMEM_LUT_SLOTS = FASTMEM_LUT_SIZE * 2, // [isc]
+
+  RAM_DIRTY_PAGE_SIZE = 4096,
+  RAM_DIRTY_PAGE_SHIFT = 12,
+  RAM_DIRTY_PAGE_COUNT = RAM_8MB_SIZE / RAM_DIRTY_PAGE_SIZE,
 };
 
 #ifdef ENABLE_MMAP_FASTMEM
@@ -128,11 +136,19 @@ void Shutdown();
 void Reset();
 bool DoState(StateWrapper& sw);
 
+/// Memory save state variant, only copies RAM pages which differ from the slot's previous contents.
+bool DoMemoryState(StateWrapper& sw, System::MemorySaveState& mss);
+
 using MemoryReadHandler = u32 (*)(VirtualMemoryAddress address);
 using MemoryWriteHandler = void (*)(VirtualMemoryAddress, u32);
 
 void** GetMemoryHandlers(bool isolate_cache, bool swap_caches);
 
+/// Returns the device's handler for a hardware register address, or nullptr if the address isn't a mapped register.
+/// Cache isolation redirects KUSEG/KSEG0 accesses to the icache, so callers need to check that themselves.
+MemoryReadHandler GetHardwareRegisterReadHandler(VirtualMemoryAddress address, MemoryAccessSize size);
+MemoryWriteHandler GetHardwareRegisterWriteHandler(VirtualMemoryAddress address, MemoryAccessSize size);
+
 template<typename FP>
 ALWAYS_INLINE_RELEASE FP* OffsetHandlerArray(void** handlers, MemoryAccessSize size, MemoryAccessType type)
 {
@@ -145,6 +161,7 @@ void RemapFastmemViews();
 bool CanUseFastmemForAddress(VirtualMemoryAddress address);
 
 extern std::bitset<RAM_8MB_CODE_PAGE_COUNT> g_ram_code_bits;
+extern std::array<u8, RAM_DIRTY_PAGE_COUNT> g_ram_dirty_pages; // Non-zero if written since the last memory state.
 extern u8* g_ram;             // 2MB-8MB RAM
 extern u8* g_unprotected_ram; // RAM without page protection, use for debugger access.
 extern u32 g_ram_size;        // Active size of RAM.
@@ -190,6 +207,25 @@ bool IsCodePageAddress(PhysicalMemoryAddress address);
 /// Returns true if the range specified overlaps with a code page.
 bool HasCodePagesInRange(PhysicalMemoryAddress start_address, u32 size);
 
+/// Flags a RAM page as modified, so the next memory save state copies it. Always indexed as 8MB, mirrors are folded.
+ALWAYS_INLINE void MarkRAMPageDirty(PhysicalMemoryAddress address)
+{
+  g_ram_dirty_pages[(address & RAM_8MB_MASK) >> RAM_DIRTY_PAGE_SHIFT] = 1;
+}
+
+/// Flags all RAM pages overlapping the specified range as modified.
+void MarkRAMRangeDirty(PhysicalMemoryAddress start_address, u32 size);
+
+/// Forces the next memory save state/load to copy all of RAM.
+void MarkAllRAMPagesDirty();
+
+/// Returns true if recompiled code must flag the pages it writes to.
+bool IsRAMDirtyPageTrackingEnabled();
+
+/// Selects how modified pages are found for memory save states, Full when they are not in use.
+/// Returns true if the code cache must be flushed.
+bool SetRAMSnapshotMode(MemorySaveStateSnapshotMode mode);
+
 /// Returns the number of cycles stolen by DMA RAM access.
 ALWAYS_INLINE TickCount GetDMARAMTickCount(u32 word_count)
 {
@@ -15,10 +15,17 @@
 
 #include "common/align.h"
 #include "common/assert.h"
+#include "common/binary_reader_writer.h"
 #include "common/error.h"
+#include "common/file_system.h"
 #include "common/intrin.h"
 #include "common/log.h"
 #include "common/memmap.h"
+#include "common/path.h"
+#include "common/time_helpers.h"
+
+#include "fmt/chrono.h"
+#include "fmt/format.h"
 
 LOG_CHANNEL(CodeCache);
 
@@ -32,6 +39,9 @@ LOG_CHANNEL(CodeCache);
 #include "cpu_recompiler.h"
 #endif
 
+#include <algorithm>
+#include <bit>
+#include <ctime>
 #include <map>
 #include <unordered_set>
 #include <zlib.h>
@@ -52,27 +62,98 @@ static constexpr u32 RECOMPILE_FRAMES_FOR_INTERPRETER_FALLBACK = 15;
 static constexpr u32 INVALIDATE_COUNT_FOR_MANUAL_PROTECTION = 4;
 static constexpr u32 INVALIDATE_FRAMES_FOR_MANUAL_PROTECTION = 60;
 
+// Hot blocks which end in a jump within the same page are recompiled together with the code at the target.
+static constexpr u32 MAX_TRACE_SEGMENTS = 4;
+static constexpr u32 MAX_TRACE_INSTRUCTIONS = 256;
+
+static constexpr u32 MAX_IDLE_LOOP_INSTRUCTIONS = 16;
+
+// Bump whenever the analysis in ReadBlockInstructions()/FillBlockRegInfo() changes.
+static constexpr const char PERSISTENT_CACHE_SIGNATURE[] = {'D', 'S', 'B', 'L', 'K', 'C', 'A', 'C'};
+static constexpr u32 PERSISTENT_CACHE_VERSION = 4;
+static constexpr u32 PERSISTENT_CACHE_MAX_BLOCK_SIZE = 0x10000;
+static constexpr const char* PERSISTENT_CACHE_DIRECTORY_NAME = "blocks";
+
+static constexpr const char* BLOCK_PROFILE_DIRECTORY_NAME = "profiles";
+
+// Blocks are carved out of chunks for size classes of 8 << n instructions, only larger blocks go to the heap.
+static constexpr u32 BLOCK_ARENA_CHUNK_SIZE = 256 * 1024;
+static constexpr u32 BLOCK_ARENA_MIN_CAPACITY_SHIFT = 3;
+static constexpr u32 BLOCK_ARENA_SIZE_CLASSES = 10;
+static constexpr u32 BLOCK_ARENA_MAX_CAPACITY = 1u << (BLOCK_ARENA_MIN_CAPACITY_SHIFT + BLOCK_ARENA_SIZE_CLASSES - 1);
+
+namespace {
+struct PersistentBlock
+{
+  PageProtectionMode protection;
+  bool recompiler_icache;
+  BlockMetadata metadata;
+  std::vector<Instruction> instructions;
+  std::vector<InstructionInfo> instructions_info;
+};
+
+struct FreeListEntry
+{
+  FreeListEntry* next;
+};
+
+struct BlockSizeClass
+{
+  std::vector<u8*> chunks;
+  u8* free_ptr;
+  u8* free_end;
+  FreeListEntry* free_list;
+};
+
+struct BlockProfile
+{
+  u64 executions;
+  u32 size;
+  u32 cycles_per_execution;
+};
+} // namespace
+
 static void AllocateLUTs();
 static void DeallocateLUTs();
 static void ResetCodeLUT();
 static void SetCodeLUT(u32 pc, const void* function);
 static void InvalidateBlock(Block* block, BlockState new_state);
+static void InvalidateBlocksInPage(PageProtectionInfo& ppi, BlockState new_block_state);
 static void ClearBlocks();
 
+static u32 GetBlockAllocationSize(u32 capacity);
+static Block* AllocateBlock(u32 size);
+static void FreeBlock(Block* block);
+static void ReleaseBlockArena();
 static Block* LookupBlock(u32 pc);
-static Block* CreateBlock(u32 pc, const BlockInstructionList& instructions, const BlockMetadata& metadata);
+static Block* CreateBlock(u32 pc, const BlockInstructionList& instructions, const BlockMetadata& metadata,
+                          bool has_reg_info);
 static bool HasBlockLUT(u32 pc);
 static bool IsBlockCodeCurrent(const Block* block);
 static bool RevalidateBlock(Block* block);
 static PageProtectionMode GetProtectionModeForPC(u32 pc);
 static PageProtectionMode GetProtectionModeForBlock(const Block* block);
-static bool ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata);
+static bool ReadBlockInstructions(u32 start_pc, bool form_trace, BlockInstructionList* instructions,
+                                  BlockMetadata* metadata);
+static bool ReadUntraceableBlockInstructions(u32 start_pc, BlockInstructionList* instructions,
+                                             BlockMetadata* metadata);
+static bool GetTraceJumpTarget(u32 start_pc, u32 branch_pc, const Instruction instruction, u32* target);
+static bool IsIdleLoop(u32 start_pc, const BlockInstructionList& instructions);
 static void FillBlockRegInfo(Block* block);
 static void CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src);
 static void SetRegAccess(InstructionInfo* inst, Reg reg, bool write);
 static void AddBlockToPageList(Block* block);
 static void RemoveBlockFromPageList(Block* block);
 
+static std::string GetPersistentCachePath(GameHash hash);
+static void LoadPersistentCache();
+static void SavePersistentCache();
+static void ClosePersistentCache();
+static bool LookupPersistentBlock(u32 pc, BlockInstructionList* instructions, BlockMetadata* metadata);
+static void InsertPersistentBlock(const Block* block);
+
+static void WriteBlockProfile();
+
 static Block* CreateCachedInterpreterBlock(u32 pc);
 [[noreturn]] static void ExecuteCachedInterpreter();
 template<PGXPMode pgxp_mode>
@@ -86,15 +167,27 @@ static std::unique_ptr<const void*[]> s_lut_code_pointers;
 static std::unique_ptr<Block*[]> s_lut_block_pointers;
 static PageProtectionArray s_page_protection = {};
 static std::vector<Block*> s_blocks;
+static std::array<BlockSizeClass, BLOCK_ARENA_SIZE_CLASSES> s_block_size_classes = {};
 
 // for compiling - reuse to avoid allocations
 static BlockInstructionList s_block_instructions;
 
+// analysed blocks for the running game, keyed by pc
+static std::unordered_map<u32, PersistentBlock> s_persistent_blocks;
+static std::unordered_set<u32> s_persistent_fastmem_faulting_pcs;
+static GameHash s_persistent_cache_hash = 0;
+static bool s_persistent_cache_dirty = false;
+
+// execution counts for profiled blocks, keyed by pc, the counters are incremented directly by the host code
+static std::unordered_map<u32, BlockProfile> s_block_profiles;
+static std::unordered_set<u32> s_block_profile_functions;
+
 static void BacklinkBlocks(u32 pc, const void* dst);
 static void UnlinkBlockExits(Block* block);
 static void ResetCodeBuffer();
 
 static void CompileASMFunctions();
+static void RecompileBlock(u32 start_pc, Block* block, bool form_trace);
 static bool CompileBlock(Block* block);
 static PageFaultHandler::HandlerResult HandleFastmemException(void* exception_pc, void* fault_address, bool is_write);
 static void BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info);
@@ -219,7 +312,9 @@ void CPU::CodeCache::Reset()
 
 void CPU::CodeCache::Shutdown()
 {
+  WriteBlockProfile();
   ClearBlocks();
+  ClosePersistentCache();
 }
 
 void CPU::CodeCache::Execute()
@@ -352,6 +447,86 @@ void CPU::CodeCache::SetCodeLUT(u32 pc, const void* function)
   g_code_lut[table][idx] = function;
 }
 
+u32 CPU::CodeCache::GetBlockAllocationSize(u32 capacity)
+{
+  return Common::AlignUpPow2(
+    static_cast<u32>(sizeof(Block) + ((sizeof(Instruction) + sizeof(InstructionInfo)) * capacity)), alignof(Block));
+}
+
+CPU::CodeCache::Block* CPU::CodeCache::AllocateBlock(u32 size)
+{
+  const u32 size_class = (size <= (1u << BLOCK_ARENA_MIN_CAPACITY_SHIFT)) ?
+                           0 :
+                           (static_cast<u32>(std::bit_width(size - 1)) - BLOCK_ARENA_MIN_CAPACITY_SHIFT);
+
+  void* ptr;
+  u32 capacity;
+  if (size_class >= BLOCK_ARENA_SIZE_CLASSES) [[unlikely]]
+  {
+    capacity = size;
+    ptr = Common::AlignedMalloc(GetBlockAllocationSize(capacity), alignof(Block));
+  }
+  else
+  {
+    capacity = 1u << (BLOCK_ARENA_MIN_CAPACITY_SHIFT + size_class);
+
+    BlockSizeClass& sc = s_block_size_classes[size_class];
+    if (sc.free_list)
+    {
+      ptr = sc.free_list;
+      sc.free_list = sc.free_list->next;
+    }
+    else
+    {
+      const u32 alloc_size = GetBlockAllocationSize(capacity);
+      if (static_cast<size_t>(sc.free_end - sc.free_ptr) < alloc_size)
+      {
+        const u32 chunk_size = std::max(BLOCK_ARENA_CHUNK_SIZE, alloc_size);
+        u8* const chunk = static_cast<u8*>(Common::AlignedMalloc(chunk_size, alignof(Block)));
+        Assert(chunk);
+        sc.chunks.push_back(chunk);
+        sc.free_ptr = chunk;
+        sc.free_end = chunk + chunk_size;
+      }
+
+      ptr = sc.free_ptr;
+      sc.free_ptr += alloc_size;
+    }
+  }
+
+  Assert(ptr);
+  Block* const block = new (ptr) Block();
+  block->capacity = capacity;
+  return block;
+}
+
+void CPU::CodeCache::FreeBlock(Block* block)
+{
+  const u32 capacity = block->capacity;
+  block->~Block();
+
+  if (capacity > BLOCK_ARENA_MAX_CAPACITY) [[unlikely]]
+  {
+    Common::AlignedFree(block);
+    return;
+  }
+
+  BlockSizeClass& sc =
+    s_block_size_classes[static_cast<u32>(std::countr_zero(capacity)) - BLOCK_ARENA_MIN_CAPACITY_SHIFT];
+  sc.free_list = new (block) FreeListEntry{sc.free_list};
+}
+
+void CPU::CodeCache::ReleaseBlockArena()
+{
+  for (BlockSizeClass& sc : s_block_size_classes)
+  {
+    for (u8* chunk : sc.chunks)
+      Common::AlignedFree(chunk);
+
+    sc = {};
+  }
+}
+
 CPU::CodeCache::Block* CPU::CodeCache::LookupBlock(u32 pc)
 {
   const u32 table = pc >> LUT_TABLE_SHIFT;
@@ -369,7 +544,7 @@ bool CPU::CodeCache::HasBlockLUT(u32 pc)
 }
 
 CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructionList& instructions,
-                                                   const BlockMetadata& metadata)
+                                                   const BlockMetadata& metadata, bool has_reg_info)
 {
   const u32 size = static_cast<u32>(instructions.size());
   const u32 table = pc >> LUT_TABLE_SHIFT;
@@ -391,27 +566,20 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
     recompile_frame = block->compile_frame;
     recompile_count = block->compile_count;
 
-    // if it has the same number of instructions, we can reuse it
-    if (block->size != size)
+    // if the instructions still fit, we can reuse it, otherwise move it to a larger size class
+    if (size > block->capacity)
     {
-      // this sucks.. hopefully won't happen very often
-      // TODO: allocate max size, allow shrink but not grow
-      auto it = std::find(s_blocks.begin(), s_blocks.end(), block);
-      Assert(it != s_blocks.end());
-      s_blocks.erase(it);
-
-      block->~Block();
-      Common::AlignedFree(block);
-      block = nullptr;
+      Block* new_block = AllocateBlock(size);
+      new_block->list_index = block->list_index;
+      s_blocks[block->list_index] = new_block;
+      FreeBlock(block);
+      block = new_block;
     }
   }
-
-  if (!block)
+  else
   {
-    block = static_cast<Block*>(Common::AlignedMalloc(
-      sizeof(Block) + (sizeof(Instruction) * size) + (sizeof(InstructionInfo) * size), alignof(Block)));
-    Assert(block);
-    new (block) Block();
+    block = AllocateBlock(size);
+    block->list_index = static_cast<u32>(s_blocks.size());
     s_blocks.push_back(block);
   }
 
@@ -466,7 +634,12 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
   }
 
   // populate backpropogation information for liveness queries
-  FillBlockRegInfo(block);
+  // blocks from the persistent cache already have it, otherwise remember it for next time
+  if (!has_reg_info)
+  {
+    FillBlockRegInfo(block);
+    InsertPersistentBlock(block);
+  }
 
   // add it to the tracking list for its page
   AddBlockToPageList(block);
@@ -492,6 +665,10 @@ bool CPU::CodeCache::RevalidateBlock(Block* block)
   if (block->state >= BlockState::NeedsRecompile)
     return false;
 
+  // Traces aren't contiguous, and are only formed once the block gets hot again anyway.
+  if (block->HasFlag(BlockFlags::IsTrace))
+    return false;
+
   // Protection may have changed if we didn't execute before it got invalidated again. e.g. THPS2.
   if (block->protection != GetProtectionModeForBlock(block))
     return false;
@@ -588,6 +765,20 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
     new_block_state = BlockState::NeedsRecompile;
   }
 
+  InvalidateBlocksInPage(ppi, new_block_state);
+}
+
+void CPU::CodeCache::InvalidateBlocksWithPageIndexForStateLoad(u32 index)
+{
+  DebugAssert(index < Bus::RAM_8MB_CODE_PAGE_COUNT);
+  Bus::ClearRAMCodePage(index);
+
+  // The guest didn't write to the page, so this shouldn't push it towards manual protection.
+  InvalidateBlocksInPage(s_page_protection[index], BlockState::Invalidated);
+}
+
+void CPU::CodeCache::InvalidateBlocksInPage(PageProtectionInfo& ppi, BlockState new_block_state)
+{
   if (!ppi.first_block_in_page)
     return;
 
@@ -673,14 +864,17 @@ void CPU::CodeCache::ClearBlocks()
 
   s_fastmem_backpatch_info.clear();
   s_fastmem_faulting_pcs.clear();
-  s_block_links.clear();
+  s_block_links.Clear();
 
   for (Block* block : s_blocks)
   {
+    const bool heap_allocated = (block->capacity > BLOCK_ARENA_MAX_CAPACITY);
     block->~Block();
-    Common::AlignedFree(block);
+    if (heap_allocated)
+      Common::AlignedFree(block);
   }
   s_blocks.clear();
+  ReleaseBlockArena();
 
   std::memset(s_lut_block_pointers.get(), 0, sizeof(Block*) * GetLUTSlotCount(false));
 }
@@ -710,8 +904,11 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
 CPU::CodeCache::Block* CPU::CodeCache::CreateCachedInterpreterBlock(u32 pc)
 {
   BlockMetadata metadata = {};
-  ReadBlockInstructions(pc, &s_block_instructions, &metadata);
-  return CreateBlock(pc, s_block_instructions, metadata);
+  const bool has_reg_info = LookupPersistentBlock(pc, &s_block_instructions, &metadata);
+  if (!has_reg_info)
+    ReadBlockInstructions(pc, false, &s_block_instructions, &metadata);
+
+  return CreateBlock(pc, s_block_instructions, metadata, has_reg_info);
 }
 
 template<PGXPMode pgxp_mode>
@@ -849,7 +1046,8 @@ void CPU::CodeCache::LogCurrentState()
 // MARK: - Block Compilation: Shared Code
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata)
+bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, bool form_trace, BlockInstructionList* instructions,
+                                           BlockMetadata* metadata)
 {
   // TODO: Jump to other block if it exists at this pc?
 
@@ -861,6 +1059,13 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
   bool is_branch_delay_slot = false;
   bool is_load_delay_slot = false;
 
+  // icache line checks assume the block is contiguous
+  const bool can_trace =
+    (protection == PageProtectionMode::WriteProtected && !(use_icache && g_settings.cpu_recompiler_icache));
+  std::array<u32, MAX_TRACE_SEGMENTS> segment_start, segment_end;
+  u32 num_segments = 1;
+  segment_start[0] = start_pc;
+
 #if 0
   if (pc == 0x0005aa90)
     __debugbreak();
@@ -889,6 +1094,12 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
           metadata->flags |= BlockFlags::SpansPages;
           break;
         }
+        else if (num_segments > 1)
+        {
+          // traces have to stay write protected, so give up and read it as a normal block
+          DEV_LOG("Trace 0x{:08X} has branch delay slot crossing page at 0x{:08X}, not forming trace", start_pc, pc);
+          return ReadUntraceableBlockInstructions(start_pc, instructions, metadata);
+        }
         else
         {
           // otherwise, we need to use manual protection in case the delay slot changes.
@@ -949,6 +1160,10 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
 
     if (is_branch_delay_slot && info.is_branch_instruction)
     {
+      // don't throw the whole block away because of a later part of the trace
+      if (num_segments > 1)
+        return ReadUntraceableBlockInstructions(start_pc, instructions, metadata);
+
       const BlockInstructionInfoPair& prev = instructions->back();
       if (!prev.second.is_unconditional_branch_instruction || !prev.second.is_direct_branch_instruction)
       {
@@ -973,7 +1188,41 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
     // if we're in a branch delay slot, the block is now done
     // except if this is a branch in a branch delay slot, then we grab the one after that, and so on...
     if (is_branch_delay_slot && !info.is_branch_instruction)
-      break;
+    {
+      // unless it's a jump within the page, in which case hot blocks can carry on at the target as a trace
+      BlockInstructionInfoPair& branch = instructions->rbegin()[1];
+      segment_end[num_segments - 1] = pc;
+      u32 target;
+      if (!can_trace || num_segments == MAX_TRACE_SEGMENTS || instructions->size() >= MAX_TRACE_INSTRUCTIONS ||
+          IsExitBlockInstruction(instruction) ||
+          (metadata->flags & BlockFlags::BranchDelaySpansPages) != BlockFlags::None ||
+          !GetTraceJumpTarget(start_pc, pc - (sizeof(Instruction) * 2), branch.first, &target))
+      {
+        break;
+      }
+
+      // loops have to go back through the dispatcher/block link for events
+      bool target_in_trace = false;
+      for (u32 i = 0; i < num_segments; i++)
+        target_in_trace |= (target >= segment_start[i] && target < segment_end[i]);
+      if (target_in_trace)
+        break;
+
+      if (!form_trace)
+      {
+        metadata->flags |= BlockFlags::CanFormTrace;
+        break;
+      }
+
+      DEBUG_LOG("Continuing trace 0x{:08X} at 0x{:08X}", start_pc, target);
+      branch.second.is_trace_branch = true;
+      metadata->flags |= BlockFlags::IsTrace;
+      segment_start[num_segments++] = target;
+      pc = target;
+      is_branch_delay_slot = false;
+      is_load_delay_slot = info.has_load_delay;
+      continue;
+    }
 
     // if this is a branch, we grab the next instruction (delay slot), and then exit
     is_branch_delay_slot = info.is_branch_instruction;
@@ -994,9 +1243,17 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
 
   instructions->back().second.is_last_instruction = true;
 
+  // icache misses make the first iteration longer than the rest
+  if (num_segments == 1 && !(use_icache && g_settings.cpu_recompiler_icache) && IsIdleLoop(start_pc, *instructions))
+  {
+    DEV_LOG("Block 0x{:08X} is an idle loop", start_pc);
+    metadata->flags |= BlockFlags::IsIdleLoop;
+  }
+
 #if defined(_DEBUG) || defined(_DEVEL)
   SmallString disasm;
   u32 disasm_pc = start_pc;
+  u32 disasm_segment = 0;
   DEBUG_LOG("Block at 0x{:08X}", start_pc);
   DEBUG_LOG(" Uncached fetch ticks: {}", metadata->uncached_fetch_ticks);
   DEBUG_LOG(" ICache line count: {}", metadata->icache_line_count);
@@ -1006,12 +1263,224 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
     DEBUG_LOG("[{} {} 0x{:08X}] {:08X} {}", cbi.second.is_branch_delay_slot ? "BD" : "  ",
               cbi.second.is_load_delay_slot ? "LD" : "  ", disasm_pc, cbi.first.bits, disasm);
     disasm_pc += sizeof(Instruction);
+
+    // traces continue at the jump target after the delay slot
+    if (cbi.second.is_branch_delay_slot && (&cbi - 1)->second.is_trace_branch)
+      disasm_pc = segment_start[++disasm_segment];
   }
 #endif
 
   return true;
 }
 
+bool CPU::CodeCache::ReadUntraceableBlockInstructions(u32 start_pc, BlockInstructionList* instructions,
+                                                      BlockMetadata* metadata)
+{
+  if (!ReadBlockInstructions(start_pc, false, instructions, metadata))
+    return false;
+
+  // Forming the trace failed, so don't count down to trying it again. Otherwise the block gets recompiled every time
+  // the countdown runs out, which doesn't count towards the interpreter fallback.
+  metadata->flags &= ~BlockFlags::CanFormTrace;
+  return true;
+}
+
+bool CPU::CodeCache::GetTraceJumpTarget(u32 start_pc, u32 branch_pc, const Instruction instruction, u32* target)
+{
+  // only jumps which are always taken, since there's no side exits
+  if (instruction.op != InstructionOp::j && instruction.op != InstructionOp::jal &&
+      (instruction.op != InstructionOp::beq || instruction.i.rs != Reg::zero || instruction.i.rt != Reg::zero))
+  {
+    return false;
+  }
+
+  // the whole trace has to be in the starting page, so writes to any part of it invalidate the block
+  *target = GetDirectBranchTarget(instruction, branch_pc);
+  return (AddressInRAM(*target) && GetSegmentForAddress(*target) == GetSegmentForAddress(start_pc) &&
+          Bus::GetRAMCodePageIndex(*target) == Bus::GetRAMCodePageIndex(start_pc));
+}
+
+bool CPU::CodeCache::IsIdleLoop(u32 start_pc, const BlockInstructionList& instructions)
+{
+  // Has to branch back to the start, with nothing else in the block but ALU ops and loads.
+  const u32 size = static_cast<u32>(instructions.size());
+  if (size < 2 || size > MAX_IDLE_LOOP_INSTRUCTIONS)
+    return false;
+
+  const u32 branch_index = size - 2;
+  const Instruction branch = instructions[branch_index].first;
+  if (!instructions[branch_index].second.is_direct_branch_instruction || branch.op == InstructionOp::jal ||
+      (branch.op == InstructionOp::b && (static_cast<u8>(branch.i.rt.GetValue()) & u8(0x1E)) == u8(0x10)) ||
+      GetDirectBranchTarget(branch, start_pc + branch_index * sizeof(Instruction)) != start_pc)
+  {
+    return false;
+  }
+
+  // Every iteration computes the same thing as long as nothing is carried over from the previous one, i.e. registers
+  // are only read before they're written if the loop never writes them. Then only an event can change what it reads.
+  u32 written_in_loop = 0;
+  for (const auto& [inst, info] : instructions)
+  {
+    if (inst.op == InstructionOp::funct)
+      written_in_loop |= (1u << static_cast<u8>(inst.r.rd.GetValue()));
+    else if (!info.is_branch_instruction)
+      written_in_loop |= (1u << static_cast<u8>(inst.i.rt.GetValue()));
+  }
+
+  u32 written = 1u;
+  std::array<u32, static_cast<u8>(Reg::count)> constant_values = {};
+  u32 constant_regs = 1u;
+  u32 load_delay_reg_bit = 0;
+  bool carried = false;
+  const auto reads = [&written, &written_in_loop, &carried](Reg reg) {
+    const u32 bit = (1u << static_cast<u8>(reg));
+    carried |= ((written_in_loop & bit) != 0 && (written & bit) == 0);
+  };
+  const auto writes = [&written, &constant_regs](Reg reg) {
+    written |= (1u << static_cast<u8>(reg));
+    constant_regs &= ~(1u << static_cast<u8>(reg)) | 1u;
+  };
+  const auto writes_constant = [&written, &constant_regs, &constant_values](Reg reg, u32 value) {
+    if (reg == Reg::zero)
+      return;
+
+    written |= (1u << static_cast<u8>(reg));
+    constant_regs |= (1u << static_cast<u8>(reg));
+    constant_values[static_cast<u8>(reg)] = value;
+  };
+  const auto get_constant = [&constant_regs, &constant_values](Reg reg) -> std::optional<u32> {
+    return (constant_regs & (1u << static_cast<u8>(reg))) ? std::optional<u32>(constant_values[static_cast<u8>(reg)]) :
+                                                            std::nullopt;
+  };
+
+  for (u32 i = 0; i < size; i++)
+  {
+    const Instruction inst = instructions[i].first;
+
+    // loaded values aren't visible until after the delay slot
+    const u32 landed_load_reg_bit = std::exchange(load_delay_reg_bit, 0);
+
+    switch (inst.op)
+    {
+      case InstructionOp::lui:
+        writes_constant(inst.i.rt, inst.i.imm_zext32() << 16);
+        break;
+
+      case InstructionOp::addiu:
+      case InstructionOp::ori:
+      {
+        reads(inst.i.rs);
+        const std::optional<u32> rs = get_constant(inst.i.rs);
+        if (rs.has_value())
+        {
+          writes_constant(inst.i.rt, (inst.op == InstructionOp::addiu) ? (rs.value() + inst.i.imm_sext32()) :
+                                                                         (rs.value() | inst.i.imm_zext32()));
+        }
+        else
+        {
+          writes(inst.i.rt);
+        }
+      }
+      break;
+
+      case InstructionOp::slti:
+      case InstructionOp::sltiu:
+      case InstructionOp::andi:
+      case InstructionOp::xori:
+        reads(inst.i.rs);
+        writes(inst.i.rt);
+        break;
+
+      case InstructionOp::lb:
+      case InstructionOp::lh:
+      case InstructionOp::lw:
+      case InstructionOp::lbu:
+      case InstructionOp::lhu:
+      {
+        // Only memory which doesn't change as time passes, or when it's read. RAM, the scratchpad and I_STAT/I_MASK.
+        reads(inst.i.rs);
+        const std::optional<u32> base = get_constant(inst.i.rs);
+        if (!base.has_value())
+          return false;
+
+        const VirtualMemoryAddress address = base.value() + inst.i.imm_sext32();
+        const PhysicalMemoryAddress phys_address = VirtualAddressToPhysical(address);
+        const u32 align_mask = (inst.op == InstructionOp::lw) ?
+                                 3u :
+                                 ((inst.op == InstructionOp::lh || inst.op == InstructionOp::lhu) ? 1u : 0u);
+        if ((address & align_mask) != 0 || GetSegmentForAddress(address) == Segment::KSEG2 ||
+            (!Bus::IsRAMAddress(phys_address) && (address & SCRATCHPAD_ADDR_MASK) != SCRATCHPAD_ADDR &&
+             (phys_address < Bus::INTC_BASE || phys_address >= (Bus::INTC_BASE + 8))))
+        {
+          return false;
+        }
+
+        constant_regs &= ~(1u << static_cast<u8>(inst.i.rt.GetValue())) | 1u;
+        load_delay_reg_bit = (1u << static_cast<u8>(inst.i.rt.GetValue()));
+      }
+      break;
+
+      case InstructionOp::j:
+        break;
+
+      case InstructionOp::beq:
+      case InstructionOp::bne:
+        reads(inst.i.rs);
+        reads(inst.i.rt);
+        break;
+
+      case InstructionOp::blez:
+      case InstructionOp::bgtz:
+      case InstructionOp::b:
+        reads(inst.i.rs);
+        break;
+
+      case InstructionOp::funct:
+      {
+        switch (inst.r.funct)
+        {
+          case InstructionFunct::sll:
+          case InstructionFunct::srl:
+          case InstructionFunct::sra:
+            reads(inst.r.rt);
+            writes(inst.r.rd);
+            break;
+
+          case InstructionFunct::sllv:
+          case InstructionFunct::srlv:
+          case InstructionFunct::srav:
+          case InstructionFunct::addu:
+          case InstructionFunct::subu:
+          case InstructionFunct::and_:
+          case InstructionFunct::or_:
+          case InstructionFunct::xor_:
+          case InstructionFunct::nor:
+          case InstructionFunct::slt:
+          case InstructionFunct::sltu:
+            reads(inst.r.rs);
+            reads(inst.r.rt);
+            writes(inst.r.rd);
+            break;
+
+          default:
+            return false;
+        }
+      }
+      break;
+
+      default:
+        return false;
+    }
+
+    written |= landed_load_reg_bit;
+    if (carried)
+      return false;
+  }
+
+  // a load in the delay slot lands in the next iteration
+  return (load_delay_reg_bit == 0);
+}
+
 void CPU::CodeCache::CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src)
 {
   std::memcpy(dst->reg_flags, src->reg_flags, sizeof(dst->reg_flags));
@@ -1275,6 +1744,383 @@ void CPU::CodeCache::FillBlockRegInfo(Block* block)
   } // end while
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Persistent Block Cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CPU::CodeCache::UpdatePersistentCache()
+{
+  const GameHash hash = (g_settings.cpu_recompiler_block_cache &&
+                         g_settings.cpu_execution_mode != CPUExecutionMode::Interpreter && !EmuFolders::Cache.empty()) ?
+                          System::GetGameHash() :
+                          0;
+  if (s_persistent_cache_hash == hash)
+    return;
+
+  ClosePersistentCache();
+
+  s_persistent_cache_hash = hash;
+  if (hash != 0)
+    LoadPersistentCache();
+}
+
+std::string CPU::CodeCache::GetPersistentCachePath(GameHash hash)
+{
+  return Path::Combine(EmuFolders::Cache, fmt::format("{}" FS_OSPATH_SEPARATOR_STR "{}.bin",
+                                                      PERSISTENT_CACHE_DIRECTORY_NAME, System::GetGameHashId(hash)));
+}
+
+void CPU::CodeCache::LoadPersistentCache()
+{
+  const std::string path = GetPersistentCachePath(s_persistent_cache_hash);
+  if (!FileSystem::FileExists(path.c_str()))
+    return;
+
+  Error error;
+  const std::optional<DynamicHeapArray<u8>> data = FileSystem::ReadBinaryFile(path.c_str(), &error);
+  if (!data.has_value())
+  {
+    WARNING_LOG("Failed to read block cache: {}", error.GetDescription());
+    return;
+  }
+
+  BinarySpanReader reader(data->cspan());
+  char signature[sizeof(PERSISTENT_CACHE_SIGNATURE)];
+  u32 version, info_size, count;
+  if (!reader.Read(signature, sizeof(signature)) ||
+      std::memcmp(signature, PERSISTENT_CACHE_SIGNATURE, sizeof(signature)) != 0 || !reader.ReadU32(&version) ||
+      version != PERSISTENT_CACHE_VERSION || !reader.ReadU32(&info_size) || info_size != sizeof(InstructionInfo) ||
+      !reader.ReadU32(&count))
+  {
+    WARNING_LOG("Block cache {} is from a different version, ignoring.", Path::GetFileName(path));
+    return;
+  }
+
+  s_persistent_blocks.reserve(count);
+  for (u32 i = 0; i < count; i++)
+  {
+    u32 pc, size, icache_line_count;
+    s32 uncached_fetch_ticks;
+    u8 protection, flags;
+    bool recompiler_icache;
+    if (!reader.ReadU32(&pc) || !reader.ReadU32(&size) || !reader.ReadU8(&protection) ||
+        !reader.ReadBool(&recompiler_icache) || !reader.ReadU8(&flags) || !reader.ReadS32(&uncached_fetch_ticks) ||
+        !reader.ReadU32(&icache_line_count) || size == 0 || size > PERSISTENT_CACHE_MAX_BLOCK_SIZE ||
+        protection >= static_cast<u8>(PageProtectionMode::Unprotected))
+    {
+      WARNING_LOG("Block cache {} is corrupted, ignoring.", Path::GetFileName(path));
+      s_persistent_blocks.clear();
+      return;
+    }
+
+    PersistentBlock& pb = s_persistent_blocks[pc];
+    pb.protection = static_cast<PageProtectionMode>(protection);
+    pb.recompiler_icache = recompiler_icache;
+    pb.metadata.uncached_fetch_ticks = uncached_fetch_ticks;
+    pb.metadata.icache_line_count = icache_line_count;
+    pb.metadata.flags = static_cast<BlockFlags>(flags);
+    pb.instructions.resize(size);
+    pb.instructions_info.resize(size);
+    if (!reader.Read(pb.instructions.data(), sizeof(Instruction) * size) ||
+        !reader.Read(pb.instructions_info.data(), sizeof(InstructionInfo) * size))
+    {
+      WARNING_LOG("Block cache {} is truncated, ignoring.", Path::GetFileName(path));
+      s_persistent_blocks.clear();
+      return;
+    }
+  }
+
+  // loadstores which went to slowmem in previous sessions, so they can be compiled that way from the start
+  u32 faulting_pc_count;
+  if (!reader.ReadU32(&faulting_pc_count))
+  {
+    WARNING_LOG("Block cache {} is truncated, ignoring.", Path::GetFileName(path));
+    s_persistent_blocks.clear();
+    return;
+  }
+
+  s_persistent_fastmem_faulting_pcs.reserve(faulting_pc_count);
+  for (u32 i = 0; i < faulting_pc_count; i++)
+  {
+    u32 pc;
+    if (!reader.ReadU32(&pc))
+    {
+      WARNING_LOG("Block cache {} is truncated, ignoring.", Path::GetFileName(path));
+      s_persistent_blocks.clear();
+      s_persistent_fastmem_faulting_pcs.clear();
+      return;
+    }
+
+    s_persistent_fastmem_faulting_pcs.insert(pc);
+  }
+
+  INFO_LOG("Loaded {} blocks and {} faulting loadstores from {}.", s_persistent_blocks.size(),
+           s_persistent_fastmem_faulting_pcs.size(), Path::GetFileName(path));
+}
+
+void CPU::CodeCache::SavePersistentCache()
+{
+  std::string path = GetPersistentCachePath(s_persistent_cache_hash);
+  Error error;
+  if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(path)).c_str(), false, &error))
+  {
+    ERROR_LOG("Failed to create block cache directory: {}", error.GetDescription());
+    return;
+  }
+
+  auto fp = FileSystem::CreateAtomicRenamedFile(std::move(path), &error);
+  if (!fp)
+  {
+    ERROR_LOG("Failed to create block cache: {}", error.GetDescription());
+    return;
+  }
+
+  BinaryFileWriter writer(fp.get());
+  writer.Write(PERSISTENT_CACHE_SIGNATURE, sizeof(PERSISTENT_CACHE_SIGNATURE));
+  writer.WriteU32(PERSISTENT_CACHE_VERSION);
+  writer.WriteU32(sizeof(InstructionInfo));
+  writer.WriteU32(static_cast<u32>(s_persistent_blocks.size()));
+  for (const auto& [pc, pb] : s_persistent_blocks)
+  {
+    const u32 size = static_cast<u32>(pb.instructions.size());
+    writer.WriteU32(pc);
+    writer.WriteU32(size);
+    writer.WriteU8(static_cast<u8>(pb.protection));
+    writer.WriteBool(pb.recompiler_icache);
+    writer.WriteU8(static_cast<u8>(pb.metadata.flags));
+    writer.WriteS32(pb.metadata.uncached_fetch_ticks);
+    writer.WriteU32(pb.metadata.icache_line_count);
+    writer.Write(pb.instructions.data(), sizeof(Instruction) * size);
+    writer.Write(pb.instructions_info.data(), sizeof(InstructionInfo) * size);
+  }
+
+  writer.WriteU32(static_cast<u32>(s_persistent_fastmem_faulting_pcs.size()));
+  for (const u32 pc : s_persistent_fastmem_faulting_pcs)
+    writer.WriteU32(pc);
+
+  if (!writer.Flush(&error))
+  {
+    ERROR_LOG("Failed to write block cache: {}", error.GetDescription());
+    FileSystem::DiscardAtomicRenamedFile(fp);
+    return;
+  }
+
+  if (!FileSystem::CommitAtomicRenamedFile(fp, &error))
+  {
+    ERROR_LOG("Failed to commit block cache: {}", error.GetDescription());
+    return;
+  }
+
+  INFO_LOG("Saved {} blocks and {} faulting loadstores to block cache.", s_persistent_blocks.size(),
+           s_persistent_fastmem_faulting_pcs.size());
+}
+
+void CPU::CodeCache::ClosePersistentCache()
+{
+  if (s_persistent_cache_hash != 0 && s_persistent_cache_dirty)
+    SavePersistentCache();
+
+  s_persistent_blocks = {};
+  s_persistent_fastmem_faulting_pcs = {};
+  s_persistent_cache_hash = 0;
+  s_persistent_cache_dirty = false;
+}
+
+bool CPU::CodeCache::LookupPersistentBlock(u32 pc, BlockInstructionList* instructions, BlockMetadata* metadata)
+{
+  if (s_persistent_cache_hash == 0 || !AddressInRAM(pc))
+    return false;
+
+  const auto it = s_persistent_blocks.find(pc);
+  if (it == s_persistent_blocks.end())
+    return false;
+
+  // The analysis depends on how the page is protected, since that determines where the block ends.
+  const PersistentBlock& pb = it->second;
+  const PhysicalMemoryAddress phys_addr = VirtualAddressToPhysical(pc);
+  const u32 size = static_cast<u32>(pb.instructions.size());
+  if (pb.protection != GetProtectionModeForPC(pc) || pb.recompiler_icache != g_settings.cpu_recompiler_icache ||
+      (phys_addr + (sizeof(Instruction) * size)) > Bus::g_ram_size ||
+      std::memcmp(Bus::g_ram + phys_addr, pb.instructions.data(), sizeof(Instruction) * size) != 0)
+  {
+    return false;
+  }
+
+  instructions->clear();
+  for (u32 i = 0; i < size; i++)
+    instructions->emplace_back(pb.instructions[i], pb.instructions_info[i]);
+
+  *metadata = pb.metadata;
+  return true;
+}
+
+void CPU::CodeCache::InsertPersistentBlock(const Block* block)
+{
+  // traces depend on the block being hot, so they're not worth keeping
+  if (s_persistent_cache_hash == 0 || !AddressInRAM(block->pc) || block->HasFlag(BlockFlags::IsTrace))
+    return;
+
+  PersistentBlock& pb = s_persistent_blocks[block->pc];
+  pb.protection = GetProtectionModeForPC(block->pc);
+  pb.recompiler_icache = g_settings.cpu_recompiler_icache;
+  pb.metadata.uncached_fetch_ticks = block->uncached_fetch_ticks;
+  pb.metadata.icache_line_count = block->icache_line_count;
+  pb.metadata.flags = block->flags;
+  pb.instructions.assign(block->Instructions(), block->Instructions() + block->size);
+  pb.instructions_info.assign(block->InstructionsInfo(), block->InstructionsInfo() + block->size);
+  s_persistent_cache_dirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Block Profiling
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+u64* CPU::CodeCache::GetBlockProfileCounter(const Block* block)
+{
+  // Memory access and GTE stall cycles aren't known until runtime, so this is only an estimate.
+  BlockProfile& profile = s_block_profiles[block->pc];
+  profile.size = block->size;
+  profile.cycles_per_execution = block->size + static_cast<u32>(std::max(block->uncached_fetch_ticks, 0));
+
+  // Targets of direct calls are the closest thing to function boundaries that we have.
+  const Instruction* instructions = block->Instructions();
+  for (u32 i = 0; i < block->size; i++)
+  {
+    if (instructions[i].op == InstructionOp::jal)
+      s_block_profile_functions.insert((block->pc & UINT32_C(0xF0000000)) | (instructions[i].j.target << 2));
+  }
+
+  return &profile.executions;
+}
+
+void CPU::CodeCache::WriteBlockProfile()
+{
+  if (s_block_profiles.empty())
+    return;
+
+  struct BlockEntry
+  {
+    u32 pc;
+    u32 function;
+    u64 executions;
+    u64 cycles;
+    u32 size;
+  };
+  struct FunctionEntry
+  {
+    u32 pc;
+    u32 blocks;
+    u64 executions;
+    u64 cycles;
+  };
+
+  std::vector<u32> functions(s_block_profile_functions.begin(), s_block_profile_functions.end());
+  std::sort(functions.begin(), functions.end());
+
+  // Blocks belong to the closest call target before them.
+  std::vector<BlockEntry> blocks;
+  std::unordered_map<u32, FunctionEntry> function_totals;
+  u64 total_executions = 0;
+  u64 total_cycles = 0;
+  blocks.reserve(s_block_profiles.size());
+  for (const auto& [pc, profile] : s_block_profiles)
+  {
+    if (profile.executions == 0)
+      continue;
+
+    const auto it = std::upper_bound(functions.begin(), functions.end(), pc);
+    const u32 function =
+      (it != functions.begin() && GetSegmentForAddress(*(it - 1)) == GetSegmentForAddress(pc)) ? *(it - 1) : pc;
+    const u64 cycles = profile.executions * profile.cycles_per_execution;
+    blocks.push_back(BlockEntry{pc, function, profile.executions, cycles, profile.size});
+
+    FunctionEntry& fe = function_totals.try_emplace(function, FunctionEntry{function, 0, 0, 0}).first->second;
+    fe.blocks++;
+    fe.executions += (function == pc) ? profile.executions : 0;
+    fe.cycles += cycles;
+    total_executions += profile.executions;
+    total_cycles += cycles;
+  }
+
+  std::vector<FunctionEntry> sorted_functions;
+  sorted_functions.reserve(function_totals.size());
+  for (const auto& [pc, fe] : function_totals)
+    sorted_functions.push_back(fe);
+
+  std::sort(blocks.begin(), blocks.end(), [](const BlockEntry& lhs, const BlockEntry& rhs) {
+    return (lhs.cycles != rhs.cycles) ? (lhs.cycles > rhs.cycles) : (lhs.pc < rhs.pc);
+  });
+  std::sort(sorted_functions.begin(), sorted_functions.end(), [](const FunctionEntry& lhs, const FunctionEntry& rhs) {
+    return (lhs.cycles != rhs.cycles) ? (lhs.cycles > rhs.cycles) : (lhs.pc < rhs.pc);
+  });
+
+  const auto percent = [total_cycles](u64 cycles) {
+    return (total_cycles > 0) ? (static_cast<double>(cycles) * 100.0 / static_cast<double>(total_cycles)) : 0.0;
+  };
+
+  std::string report;
+  fmt::format_to(std::back_inserter(report), "{{\n  \"total_executions\": {},\n  \"total_estimated_cycles\": {},\n",
+                 total_executions, total_cycles);
+  report.append("  \"functions\": [\n");
+  for (size_t i = 0; i < sorted_functions.size(); i++)
+  {
+    const FunctionEntry& fe = sorted_functions[i];
+    fmt::format_to(std::back_inserter(report),
+                   "    {{\"pc\": \"{:08X}\", \"blocks\": {}, \"entry_executions\": {}, \"estimated_cycles\": {}, "
+                   "\"percent\": {:.3f}}}{}\n",
+                   fe.pc, fe.blocks, fe.executions, fe.cycles, percent(fe.cycles),
+                   ((i + 1) < sorted_functions.size()) ? "," : "");
+  }
+  report.append("  ],\n  \"blocks\": [\n");
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    const BlockEntry& be = blocks[i];
+    fmt::format_to(std::back_inserter(report),
+                   "    {{\"pc\": \"{:08X}\", \"function\": \"{:08X}\", \"size\": {}, \"executions\": {}, "
+                   "\"estimated_cycles\": {}, \"percent\": {:.3f}}}{}\n",
+                   be.pc, be.function, be.size, be.executions, be.cycles, percent(be.cycles),
+                   ((i + 1) < blocks.size()) ? "," : "");
+  }
+  report.append("  ]\n}\n");
+
+  // Same format as /tmp/perf-<pid>.map, so it can be merged with the PerfScope output for the current blocks.
+  std::string perf_map;
+  for (const Block* block : s_blocks)
+  {
+    const auto it = s_block_profiles.find(block->pc);
+    if (block->state != BlockState::Valid || !block->host_code || it == s_block_profiles.end())
+      continue;
+
+    fmt::format_to(std::back_inserter(perf_map), "{:x} {:x} MIPS_{:08X} [{} executions]\n",
+                   reinterpret_cast<uintptr_t>(block->host_code), block->host_code_size, block->pc,
+                   it->second.executions);
+  }
+
+  const std::string& serial = System::GetGameSerial();
+  const std::string base_path = Path::Combine(
+    EmuFolders::DataRoot,
+    fmt::format("{}" FS_OSPATH_SEPARATOR_STR "{} {:%Y-%m-%d-%H-%M-%S}", BLOCK_PROFILE_DIRECTORY_NAME,
+                serial.empty() ? std::string("unknown") : Path::SanitizeFileName(serial),
+                Common::LocalTime(std::time(nullptr)).value_or(std::tm{})));
+
+  Error error;
+  const std::string report_path = base_path + ".json";
+  const std::string map_path = base_path + ".map";
+  if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(base_path)).c_str(), false, &error) ||
+      !FileSystem::WriteStringToFile(report_path.c_str(), report, &error) ||
+      !FileSystem::WriteStringToFile(map_path.c_str(), perf_map, &error))
+  {
+    ERROR_LOG("Failed to write block profile: {}", error.GetDescription());
+  }
+  else
+  {
+    INFO_LOG("Wrote profile for {} blocks to {}", blocks.size(), Path::GetFileName(report_path));
+  }
+
+  s_block_profiles = {};
+  s_block_profile_functions = {};
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // MARK: - Recompiler Glue
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1298,7 +2144,16 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
       MemMap::EndCodeWrite();
       return;
     }
+  }
 
+  RecompileBlock(start_pc, block, false);
+  MemMap::EndCodeWrite();
+}
+
+void CPU::CodeCache::RecompileBlock(u32 start_pc, Block* block, bool form_trace)
+{
+  if (block)
+  {
     // remove outward links from this block, since we're recompiling it
     UnlinkBlockExits(block);
 
@@ -1308,15 +2163,18 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
   }
 
   BlockMetadata metadata = {};
-  if (!ReadBlockInstructions(start_pc, &s_block_instructions, &metadata))
+  const bool has_reg_info = !form_trace && LookupPersistentBlock(start_pc, &s_block_instructions, &metadata);
+  if (!has_reg_info && !ReadBlockInstructions(start_pc, form_trace, &s_block_instructions, &metadata))
   {
     ERROR_LOG("Failed to read block at 0x{:08X}, falling back to uncached interpreter", start_pc);
     SetCodeLUT(start_pc, g_interpret_block);
     BacklinkBlocks(start_pc, g_interpret_block);
-    MemMap::EndCodeWrite();
     return;
   }
 
+  // blocks read when forming a trace never count down to forming another, whether or not the trace was formed
+  DebugAssert(!form_trace || (metadata.flags & BlockFlags::CanFormTrace) == BlockFlags::None);
+
   // Ensure we're not going to run out of space while compiling this block.
   // We could definitely do better here...
   const u32 block_size = static_cast<u32>(s_block_instructions.size());
@@ -1330,30 +2188,43 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
     CodeCache::Reset();
   }
 
-  if ((block = CreateBlock(start_pc, s_block_instructions, metadata)) == nullptr || block->size == 0 ||
+  if ((block = CreateBlock(start_pc, s_block_instructions, metadata, has_reg_info)) == nullptr || block->size == 0 ||
       !CompileBlock(block))
   {
     ERROR_LOG("Failed to compile block at 0x{:08X}, falling back to uncached interpreter", start_pc);
     SetCodeLUT(start_pc, g_interpret_block);
     BacklinkBlocks(start_pc, g_interpret_block);
-    MemMap::EndCodeWrite();
     return;
   }
 
   SetCodeLUT(start_pc, block->host_code);
   BacklinkBlocks(start_pc, block->host_code);
-  MemMap::EndCodeWrite();
 }
 
 void CPU::CodeCache::DiscardAndRecompileBlock(u32 start_pc)
 {
   MemMap::BeginCodeWrite();
 
-  DEV_LOG("Discard block {:08X} with manual protection", start_pc);
   Block* block = LookupBlock(start_pc);
   DebugAssert(block && block->state == BlockState::Valid);
+
+  // Write protected blocks only come here when their execution countdown runs out, i.e. they're hot.
+  const bool form_trace = (block->protection == PageProtectionMode::WriteProtected);
+  if (form_trace)
+  {
+    DEV_LOG("Forming trace from hot block {:08X}", start_pc);
+
+    // not a recompile due to modification, so it shouldn't count towards the interpreter fallback
+    RemoveBlockFromPageList(block);
+    block->compile_count--;
+  }
+  else
+  {
+    DEV_LOG("Discard block {:08X} with manual protection", start_pc);
+  }
+
   InvalidateBlock(block, BlockState::NeedsRecompile);
-  CompileOrRevalidateBlock(start_pc);
+  RecompileBlock(start_pc, block, form_trace);
 
   MemMap::EndCodeWrite();
 }
@@ -1380,9 +2251,8 @@ const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
       dst = HasBlockLUT(newpc) ? g_compile_or_revalidate_block : g_interpret_block;
     }
 
-    BlockLinkMap::iterator iter = s_block_links.emplace(newpc, code);
     DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
-    block->exit_links[block->num_exit_links++] = iter;
+    block->exit_links[block->num_exit_links++] = s_block_links.Insert(newpc, code);
   }
 
   DEBUG_LOG("Linking {} with dst pc {:08X} to {}{}", code, newpc, dst,
@@ -1397,34 +2267,42 @@ const void* CPU::CodeCache::CreateSelfBlockLink(Block* block, void* code, const
   {
     dst = block_start;
 
-    BlockLinkMap::iterator iter = s_block_links.emplace(block->pc, code);
     DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
-    block->exit_links[block->num_exit_links++] = iter;
+    block->exit_links[block->num_exit_links++] = s_block_links.Insert(block->pc, code);
   }
 
   DEBUG_LOG("Self linking {} with dst pc {:08X} to {}", code, block->pc, dst);
   return dst;
 }
 
+void CPU::CodeCache::SkipIdleLoop()
+{
+  // Nothing changes until the next event, so every iteration until then would take the same time as this one.
+  const u32 iteration_ticks = g_state.pending_ticks - g_state.idle_loop_start_ticks;
+  if (g_state.pending_ticks >= g_state.downcount || iteration_ticks == 0)
+    return;
+
+  const u32 iterations = (g_state.downcount - g_state.pending_ticks + iteration_ticks - 1) / iteration_ticks;
+  g_state.pending_ticks += iterations * iteration_ticks;
+}
+
 void CPU::CodeCache::BacklinkBlocks(u32 pc, const void* dst)
 {
   if (!g_settings.cpu_recompiler_block_linking)
     return;
 
-  const auto link_range = s_block_links.equal_range(pc);
-  for (auto it = link_range.first; it != link_range.second; ++it)
-  {
-    DEBUG_LOG("Backlinking {} with dst pc {:08X} to {}{}", it->second, pc, dst,
+  s_block_links.ForEach(pc, [&](void* code) {
+    DEBUG_LOG("Backlinking {} with dst pc {:08X} to {}{}", code, pc, dst,
               (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
-    EmitJump(it->second, dst, true);
-  }
+    EmitJump(code, dst, true);
+  });
 }
 
 void CPU::CodeCache::UnlinkBlockExits(Block* block)
 {
   const u32 num_exit_links = block->num_exit_links;
   for (u32 i = 0; i < num_exit_links; i++)
-    s_block_links.erase(block->exit_links[i]);
+    s_block_links.Remove(block->exit_links[i]);
   block->num_exit_links = 0;
 }
 
@@ -1721,13 +2599,18 @@ PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(void* exc
 
   // and store the pc in the faulting list, so that we don't emit another fastmem loadstore
   s_fastmem_faulting_pcs.insert(info.guest_pc);
+  if (s_persistent_cache_hash != 0 && s_persistent_fastmem_faulting_pcs.insert(info.guest_pc).second)
+    s_persistent_cache_dirty = true;
+
   s_fastmem_backpatch_info.erase(iter);
   return PageFaultHandler::HandlerResult::ContinueExecution;
 }
 
 bool CPU::CodeCache::HasPreviouslyFaultedOnPC(u32 guest_pc)
 {
-  return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
+  // Faults from previous sessions are kept separately, since the session list is cleared with the blocks.
+  return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end() ||
+          s_persistent_fastmem_faulting_pcs.find(guest_pc) != s_persistent_fastmem_faulting_pcs.end());
 }
 
 void CPU::CodeCache::BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info)
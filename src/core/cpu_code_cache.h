@@ -31,9 +31,15 @@ void Reset();
 /// Free all non-persistent resources for the code cache.
 void Shutdown();
 
+/// Loads the persistent block cache for the running game, saving the previous game's if it changed.
+void UpdatePersistentCache();
+
 /// Invalidates all blocks which are in the range of the specified code page.
 void InvalidateBlocksWithPageIndex(u32 page_index);
 
+/// Invalidates all blocks in the specified code page, because its contents are being replaced by a memory state.
+void InvalidateBlocksWithPageIndexForStateLoad(u32 page_index);
+
 /// Invalidates all blocks in the cache.
 void InvalidateAllRAMBlocks();
 
@@ -5,6 +5,7 @@
 
 #include "bus.h"
 #include "common/bitfield.h"
+#include "common/flat_multimap.h"
 #include "common/perf_scope.h"
 #include "cpu_code_cache.h"
 #include "cpu_core_private.h"
@@ -26,7 +27,7 @@ enum : u32
 
 using CodeLUT = const void**;
 using CodeLUTArray = std::array<CodeLUT, LUT_TABLE_COUNT>;
-using BlockLinkMap = std::unordered_multimap<u32, void*>; // TODO: try ordered?
+using BlockLinkMap = FlatMultiMap<void*>; // target pc -> branch in host code
 
 enum RegInfoFlags : u8
 {
@@ -46,6 +47,7 @@ struct InstructionInfo
   bool is_load_delay_slot : 1;
   bool is_last_instruction : 1;
   bool has_load_delay : 1;
+  bool is_trace_branch : 1; // jump is followed to its target within the block
 
   u8 reg_flags[static_cast<u8>(Reg::count)];
   // Reg write_reg[3];
@@ -89,6 +91,9 @@ enum class BlockFlags : u8
   BranchDelaySpansPages = (1 << 2),
   IsUsingICache = (1 << 3),
   NeedsDynamicFetchTicks = (1 << 4),
+  CanFormTrace = (1 << 5),
+  IsTrace = (1 << 6),
+  IsIdleLoop = (1 << 7),
 };
 IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(BlockFlags);
 
@@ -115,7 +120,7 @@ struct alignas(16) Block
   // links to previous/next block within page
   Block* next_block_in_page;
 
-  BlockLinkMap::iterator exit_links[MAX_BLOCK_EXIT_LINKS];
+  BlockLinkMap::Handle exit_links[MAX_BLOCK_EXIT_LINKS];
   u8 num_exit_links;
 
   // TODO: Move up so it's part of the same cache line
@@ -130,6 +135,13 @@ struct alignas(16) Block
   u32 compile_frame;
   u8 compile_count;
 
+  // number of instructions the allocation can hold, and position in the block list
+  u32 capacity;
+  u32 list_index;
+
+  // executions remaining until the block is recompiled as a trace, decremented by the host code
+  u32 trace_countdown;
+
   // followed by Instruction * size, InstructionRegInfo * size
   ALWAYS_INLINE const Instruction* Instructions() const { return reinterpret_cast<const Instruction*>(this + 1); }
   ALWAYS_INLINE Instruction* Instructions() { return reinterpret_cast<Instruction*>(this + 1); }
@@ -236,9 +248,13 @@ const void* GetInterpretUncachedBlockFunction();
 
 void CompileOrRevalidateBlock(u32 start_pc);
 void DiscardAndRecompileBlock(u32 start_pc);
+u64* GetBlockProfileCounter(const Block* block);
 const void* CreateBlockLink(Block* from_block, void* code, u32 newpc);
 const void* CreateSelfBlockLink(Block* block, void* code, const void* block_start);
 
+/// Advances pending ticks by whole iterations of an idle loop, up to the next event.
+void SkipIdleLoop();
+
 void AddLoadStoreInfo(void* code_address, u32 code_size, u32 guest_pc, const void* thunk_address);
 void AddLoadStoreInfo(void* code_address, u32 code_size, u32 guest_pc, u32 guest_block, TickCount cycles,
                       u32 gpr_bitmask, u8 address_register, u8 data_register, MemoryAccessSize size, bool is_signed,
@@ -3087,6 +3087,7 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
     else
     {
       const u32 page_index = offset >> HOST_PAGE_SHIFT;
+      MarkRAMPageDirty(offset);
 
       if constexpr (size == MemoryAccessSize::Byte)
       {
@@ -3284,6 +3285,7 @@ bool CPU::SafeWriteMemoryBytes(VirtualMemoryAddress addr, const void* data, u32
 
   // Fast path: all in RAM, no wraparound.
   std::memcpy(&g_ram[addr & g_ram_mask], data, length);
+  MarkRAMRangeDirty(addr & KSEG_MASK, length);
   return true;
 }
 
@@ -3330,6 +3332,7 @@ bool CPU::SafeZeroMemoryBytes(VirtualMemoryAddress addr, u32 length)
 
   // Fast path: all in RAM, no wraparound.
   std::memset(&g_ram[addr & g_ram_mask], 0, length);
+  MarkRAMRangeDirty(addr & KSEG_MASK, length);
   return true;
 }
 
@@ -78,6 +78,7 @@ struct ALIGN_TO_CACHE_LINE State
   u32 pending_ticks = 0;
   u32 gte_completion_tick = 0;
   u32 muldiv_completion_tick = 0;
+  u32 idle_loop_start_ticks = 0;
 
   Registers regs = {};
   Cop0Registers cop0_regs = {};
@@ -80,6 +80,26 @@ void CPU::Recompiler::Recompiler::BeginBlock()
     GenerateBlockProtectCheck(ram_ptr, shadow_ptr, m_block->size * sizeof(Instruction));
   }
 
+  // idle loops skip ahead by whole iterations, so we need to know how long this one took
+  if (IsSkippingIdleLoop())
+  {
+    const u32 reg = AllocateTempHostReg();
+    LoadHostRegFromCPUPointer(reg, &g_state.pending_ticks);
+    StoreHostRegToCPUPointer(reg, &g_state.idle_loop_start_ticks);
+    FreeHostReg(reg);
+  }
+
+  // count executions of blocks which can become traces, and recompile them when they get hot
+  if (m_block->HasFlag(CodeCache::BlockFlags::CanFormTrace) &&
+      m_block->protection == CodeCache::PageProtectionMode::WriteProtected && g_settings.cpu_recompiler_traces)
+  {
+    m_block->trace_countdown = TRACE_HOT_BLOCK_EXECUTIONS;
+    GenerateTraceCountdown(&m_block->trace_countdown);
+  }
+
+  if (g_settings.cpu_recompiler_block_profiling)
+    GenerateProfileCounterIncrement(CodeCache::GetBlockProfileCounter(m_block));
+
   GenerateICacheCheckAndUpdate();
 
   if (g_settings.bios_tty_logging)
@@ -1715,9 +1735,13 @@ void CPU::Recompiler::Recompiler::CompileLoadStoreTemplate(
       GetSegmentForAddress(spec_addr.value()) != Segment::KSEG2)
   {
     // Get rid of physical aliases.
+    // Traces can jump backwards within the page, so any write to it could hit a later instruction.
     const u32 phys_spec_addr = VirtualAddressToPhysical(spec_addr.value());
-    if (phys_spec_addr >= VirtualAddressToPhysical(m_compiler_pc) &&
-        phys_spec_addr < VirtualAddressToPhysical(m_block->pc + (m_block->size * sizeof(Instruction))))
+    if (m_block->HasFlag(CodeCache::BlockFlags::IsTrace) ?
+          (Bus::IsRAMAddress(phys_spec_addr) &&
+           Bus::GetRAMCodePageIndex(phys_spec_addr) == m_block->StartPageIndex()) :
+          (phys_spec_addr >= VirtualAddressToPhysical(m_compiler_pc) &&
+           phys_spec_addr < VirtualAddressToPhysical(m_block->pc + (m_block->size * sizeof(Instruction)))))
     {
       WARNING_LOG("Instruction {:08X} speculatively writes to {:08X} inside block {:08X}-{:08X}. Truncating block.",
                   m_current_instruction_pc, phys_spec_addr, m_block->pc,
@@ -1729,10 +1753,29 @@ void CPU::Recompiler::Recompiler::CompileLoadStoreTemplate(
 
 void CPU::Recompiler::Recompiler::TruncateBlock()
 {
-  m_block->size = ((m_current_instruction_pc - m_block->pc) / sizeof(Instruction)) + 1;
+  // traces aren't contiguous, so go by the position in the block rather than the pc
+  m_block->size = static_cast<u32>(inst - m_block->Instructions()) + 1;
   iinfo->is_last_instruction = true;
 }
 
+bool CPU::Recompiler::Recompiler::IsSkippingIdleLoop() const
+{
+  return (g_settings.cpu_recompiler_idle_loop_skipping && m_block->HasFlag(CodeCache::BlockFlags::IsIdleLoop));
+}
+
+void CPU::Recompiler::Recompiler::EndBlockOrContinueTrace(u32 newpc)
+{
+  // traces carry on at the jump target after the delay slot, without flushing anything
+  if ((iinfo - 1)->is_trace_branch)
+  {
+    m_current_instruction_pc = newpc - sizeof(Instruction);
+    m_compiler_pc = newpc;
+    return;
+  }
+
+  EndBlock(newpc, true);
+}
+
 const TickCount* CPU::Recompiler::Recompiler::GetFetchMemoryAccessTimePtr() const
 {
   const TickCount* ptr = Bus::GetMemoryAccessTimePtr(VirtualAddressToPhysical(m_block->pc), MemoryAccessSize::Word);
@@ -1750,6 +1793,26 @@ void CPU::Recompiler::Recompiler::FlushForLoadStore(const std::optional<VirtualM
   Flush(FLUSH_FOR_C_CALL | FLUSH_FOR_LOADSTORE);
 }
 
+const void* CPU::Recompiler::Recompiler::GetHardwareRegisterHandler(const std::optional<VirtualMemoryAddress>& address,
+                                                                     MemoryAccessSize size, bool store)
+{
+  // Memory exceptions need the alignment and bus error checks in the thunks. Cache isolation is only set by the BIOS
+  // flush routines, which don't touch the hardware registers, but if we know it's set, leave it to the LUT.
+  if (!address.has_value() || g_settings.cpu_recompiler_memory_exceptions ||
+      (GetSegmentForAddress(address.value()) != Segment::KSEG1 && SpecIsCacheIsolated()))
+  {
+    return nullptr;
+  }
+
+  const void* handler =
+    store ? reinterpret_cast<const void*>(Bus::GetHardwareRegisterWriteHandler(address.value(), size)) :
+            reinterpret_cast<const void*>(Bus::GetHardwareRegisterReadHandler(address.value(), size));
+  if (handler)
+    DEBUG_LOG("Calling hardware register handler directly for {:08X}", address.value());
+
+  return handler;
+}
+
 void CPU::Recompiler::Recompiler::CompileMoveRegTemplate(Reg dst, Reg src, bool pgxp_move)
 {
   if (dst == src || dst == Reg::zero)
@@ -1787,7 +1850,7 @@ void CPU::Recompiler::Recompiler::Compile_j()
   // TODO: Delay slot swap.
   // We could also move the cycle commit back.
   CompileBranchDelaySlot();
-  EndBlock(newpc, true);
+  EndBlockOrContinueTrace(newpc);
 }
 
 void CPU::Recompiler::Recompiler::Compile_jr_const(CompileFlags cf)
@@ -1809,7 +1872,7 @@ void CPU::Recompiler::Recompiler::Compile_jal()
   const u32 newpc = (m_compiler_pc & UINT32_C(0xF0000000)) | (inst->j.target << 2);
   SetConstantReg(Reg::ra, GetBranchReturnAddress({}));
   CompileBranchDelaySlot();
-  EndBlock(newpc, true);
+  EndBlockOrContinueTrace(newpc);
 }
 
 void CPU::Recompiler::Recompiler::Compile_jalr_const(CompileFlags cf)
@@ -1942,7 +2005,7 @@ void CPU::Recompiler::Recompiler::Compile_bxx_const(CompileFlags cf, BranchCondi
 
   const u32 taken_pc = GetConditionalBranchTarget(cf);
   CompileBranchDelaySlot();
-  EndBlock(taken ? taken_pc : m_compiler_pc, true);
+  EndBlockOrContinueTrace(taken ? taken_pc : m_compiler_pc);
 }
 
 void CPU::Recompiler::Recompiler::Compile_sll_const(CompileFlags cf)
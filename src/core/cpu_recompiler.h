@@ -21,6 +21,9 @@ public:
   static constexpr bool EMULATE_LOAD_DELAYS = true;
   static constexpr bool SWAP_BRANCH_DELAY_SLOTS = true;
 
+  // Number of executions before a block ending in a jump is recompiled as a trace.
+  static constexpr u32 TRACE_HOT_BLOCK_EXECUTIONS = 1000;
+
   // Arch-specific options
 #if defined(CPU_ARCH_X64)
 
@@ -256,6 +259,10 @@ protected:
   bool TrySwapDelaySlot(Reg rs = Reg::zero, Reg rt = Reg::zero, Reg rd = Reg::zero);
   void SetCompilerPC(u32 newpc);
   void TruncateBlock();
+  void EndBlockOrContinueTrace(u32 newpc);
+
+  /// Returns true if the block loops back to itself without doing anything until the next event.
+  bool IsSkippingIdleLoop() const;
 
   const TickCount* GetFetchMemoryAccessTimePtr() const;
 
@@ -266,6 +273,8 @@ protected:
   virtual void BeginBlock();
   virtual void GenerateBlockProtectCheck(const u8* ram_ptr, const u8* shadow_ptr, u32 size) = 0;
   virtual void GenerateICacheCheckAndUpdate() = 0;
+  virtual void GenerateTraceCountdown(u32* counter) = 0;
+  virtual void GenerateProfileCounterIncrement(u64* counter) = 0;
   virtual void GenerateCall(const void* func, s32 arg1reg = -1, s32 arg2reg = -1, s32 arg3reg = -1) = 0;
   virtual void EndBlock(const std::optional<u32>& newpc, bool do_event_test) = 0;
   virtual void EndBlockWithException(Exception excode) = 0;
@@ -331,6 +340,10 @@ protected:
                                                          const std::optional<VirtualMemoryAddress>&),
                                 MemoryAccessSize size, bool store, bool sign, u32 tflags);
   void FlushForLoadStore(const std::optional<VirtualMemoryAddress>& address, bool store, bool use_fastmem);
+
+  /// Returns the device handler to call for a slowmem access to a constant hardware register address, or nullptr.
+  const void* GetHardwareRegisterHandler(const std::optional<VirtualMemoryAddress>& address, MemoryAccessSize size,
+                                         bool store);
   void CompileMoveRegTemplate(Reg dst, Reg src, bool pgxp_move);
 
   virtual void GeneratePGXPCallWithMIPSRegs(const void* func, u32 arg1val, Reg arg2reg = Reg::count,
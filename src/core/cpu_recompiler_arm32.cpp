@@ -597,6 +597,30 @@ bool foo(const void* a, const void* b)
   armAsm->bind(&block_unchanged);
 }
 
+void CPU::ARM32Recompiler::GenerateTraceCountdown(u32* counter)
+{
+  armMoveAddressToReg(armAsm, RARG1, counter);
+  armAsm->ldr(RARG2, MemOperand(RARG1));
+  armAsm->subs(RARG2, RARG2, 1);
+  armAsm->str(RARG2, MemOperand(RARG1));
+
+  Label not_hot;
+  armAsm->b(ne, &not_hot);
+  armEmitJmp(armAsm, CodeCache::g_discard_and_recompile_block, false);
+  armAsm->bind(&not_hot);
+}
+
+void CPU::ARM32Recompiler::GenerateProfileCounterIncrement(u64* counter)
+{
+  armMoveAddressToReg(armAsm, RARG1, counter);
+  armAsm->ldr(RARG2, MemOperand(RARG1));
+  armAsm->ldr(RARG3, MemOperand(RARG1, sizeof(u32)));
+  armAsm->adds(RARG2, RARG2, 1);
+  armAsm->adc(RARG3, RARG3, 0);
+  armAsm->str(RARG2, MemOperand(RARG1));
+  armAsm->str(RARG3, MemOperand(RARG1, sizeof(u32)));
+}
+
 void CPU::ARM32Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -760,6 +784,11 @@ void CPU::ARM32Recompiler::EndAndLinkBlock(const std::optional<u32>& newpc, bool
   {
     armEmitJmp(armAsm, CodeCache::g_dispatcher, false);
   }
+  else if (newpc.value() == m_block->pc && IsSkippingIdleLoop())
+  {
+    EmitCall(reinterpret_cast<const void*>(&CodeCache::SkipIdleLoop));
+    armEmitJmp(armAsm, CodeCache::g_run_events_and_dispatch, false);
+  }
   else
   {
     const void* target = (newpc.value() == m_block->pc) ?
@@ -1682,6 +1711,7 @@ CPU::ARM32Recompiler::ComputeLoadStoreAddressArg(CompileFlags cf, const std::opt
 template<typename RegAllocFn>
 vixl::aarch32::Register CPU::ARM32Recompiler::GenerateLoad(const vixl::aarch32::Register& addr_reg,
                                                            MemoryAccessSize size, bool sign, bool use_fastmem,
+                                                           const void* direct_handler,
                                                            const RegAllocFn& dst_reg_alloc)
 {
   if (use_fastmem)
@@ -1720,26 +1750,34 @@ vixl::aarch32::Register CPU::ARM32Recompiler::GenerateLoad(const vixl::aarch32::
     armAsm->mov(RARG1, addr_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryByte) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    EmitCall(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryByte) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1794,7 +1832,7 @@ vixl::aarch32::Register CPU::ARM32Recompiler::GenerateLoad(const vixl::aarch32::
 
 void CPU::ARM32Recompiler::GenerateStore(const vixl::aarch32::Register& addr_reg,
                                          const vixl::aarch32::Register& value_reg, MemoryAccessSize size,
-                                         bool use_fastmem)
+                                         bool use_fastmem, const void* direct_handler)
 {
   if (use_fastmem)
   {
@@ -1821,6 +1859,17 @@ void CPU::ARM32Recompiler::GenerateStore(const vixl::aarch32::Register& addr_reg
         break;
     }
     AddLoadStoreInfo(start, kA32InstructionSizeInBytes, addr_reg.GetCode(), value_reg.GetCode(), size, false, false);
+
+    // Flag the page as modified for memory save states. Harmless if the store was backpatched to a non-RAM address.
+    if (Bus::IsRAMDirtyPageTrackingEnabled())
+    {
+      armAsm->ubfx(RARG3, addr_reg, Bus::RAM_DIRTY_PAGE_SHIFT, std::bit_width(Bus::RAM_DIRTY_PAGE_COUNT - 1u));
+      armMoveAddressToReg(armAsm, RSCRATCH, Bus::g_ram_dirty_pages.data());
+      armAsm->add(RARG3, RARG3, RSCRATCH);
+      armEmitMov(armAsm, RSCRATCH, 1);
+      armAsm->strb(RSCRATCH, MemOperand(RARG3));
+    }
+
     return;
   }
 
@@ -1830,26 +1879,34 @@ void CPU::ARM32Recompiler::GenerateStore(const vixl::aarch32::Register& addr_reg
     armAsm->mov(RARG2, value_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryByte) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    EmitCall(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryByte) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1886,7 +1943,8 @@ void CPU::ARM32Recompiler::Compile_lxx(CompileFlags cf, MemoryAccessSize size, b
                                              std::optional<Register>();
   FlushForLoadStore(address, false, use_fastmem);
   const Register addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const Register data = GenerateLoad(addr, size, sign, use_fastmem, [this, cf]() {
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, false);
+  const Register data = GenerateLoad(addr, size, sign, use_fastmem, direct_handler, [this, cf]() {
     if (cf.MipsT() == Reg::zero)
       return RRET;
 
@@ -1934,7 +1992,7 @@ void CPU::ARM32Recompiler::Compile_lwx(CompileFlags cf, MemoryAccessSize size, b
   }
 
   armAsm->bic(RARG1, addr, 3);
-  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RRET; });
+  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RRET; });
 
   if (inst->r.rt == Reg::zero)
   {
@@ -2012,11 +2070,12 @@ void CPU::ARM32Recompiler::Compile_lwc2(CompileFlags cf, MemoryAccessSize size,
                                              std::optional<Register>();
   FlushForLoadStore(address, false, use_fastmem);
   const Register addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const Register value = GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, [this, action = action]() {
-    return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
-             Register(AllocateTempHostReg(HR_CALLEE_SAVED)) :
-             RRET;
-  });
+  const Register value =
+    GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, nullptr, [this, action = action]() {
+      return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
+               Register(AllocateTempHostReg(HR_CALLEE_SAVED)) :
+               RRET;
+    });
 
   switch (action)
   {
@@ -2099,11 +2158,12 @@ void CPU::ARM32Recompiler::Compile_sxx(CompileFlags cf, MemoryAccessSize size, b
                                              std::optional<Register>();
   FlushForLoadStore(address, true, use_fastmem);
   const Register addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, true);
   const Register data = cf.valid_host_t ? CFGetRegT(cf) : RARG2;
   if (!cf.valid_host_t)
     MoveTToReg(RARG2, cf);
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, direct_handler);
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -2141,7 +2201,7 @@ void CPU::ARM32Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size, b
   }
 
   armAsm->bic(RARG1, addr, 3);
-  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RRET; });
+  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RRET; });
 
   armAsm->and_(RSCRATCH, addr, 3);
   armAsm->lsl(RSCRATCH, RSCRATCH, 3); // *8
@@ -2176,7 +2236,7 @@ void CPU::ARM32Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size, b
     armAsm->orr(RARG2, RARG2, RRET);
   }
 
-  GenerateStore(addr, RARG2, MemoryAccessSize::Word, use_fastmem);
+  GenerateStore(addr, RARG2, MemoryAccessSize::Word, use_fastmem, nullptr);
   FreeHostReg(addr.GetCode());
 }
 
@@ -2217,7 +2277,7 @@ void CPU::ARM32Recompiler::Compile_swc2(CompileFlags cf, MemoryAccessSize size,
     break;
   }
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, nullptr);
   if (!g_settings.gpu_pgxp_enable)
   {
     if (addr.GetCode() != RARG1.GetCode())
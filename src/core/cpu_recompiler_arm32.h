@@ -36,6 +36,8 @@ protected:
   void BeginBlock() override;
   void GenerateBlockProtectCheck(const u8* ram_ptr, const u8* shadow_ptr, u32 size) override;
   void GenerateICacheCheckAndUpdate() override;
+  void GenerateTraceCountdown(u32* counter) override;
+  void GenerateProfileCounterIncrement(u64* counter) override;
   void GenerateCall(const void* func, s32 arg1reg = -1, s32 arg2reg = -1, s32 arg3reg = -1) override;
   void EndBlock(const std::optional<u32>& newpc, bool do_event_test) override;
   void EndBlockWithException(Exception excode) override;
@@ -100,9 +102,10 @@ protected:
                              const std::optional<const vixl::aarch32::Register>& reg = std::nullopt);
   template<typename RegAllocFn>
   vixl::aarch32::Register GenerateLoad(const vixl::aarch32::Register& addr_reg, MemoryAccessSize size, bool sign,
-                                       bool use_fastmem, const RegAllocFn& dst_reg_alloc);
+                                       bool use_fastmem, const void* direct_handler,
+                                       const RegAllocFn& dst_reg_alloc);
   void GenerateStore(const vixl::aarch32::Register& addr_reg, const vixl::aarch32::Register& value_reg,
-                     MemoryAccessSize size, bool use_fastmem);
+                     MemoryAccessSize size, bool use_fastmem, const void* direct_handler);
   void Compile_lxx(CompileFlags cf, MemoryAccessSize size, bool sign, bool use_fastmem,
                    const std::optional<VirtualMemoryAddress>& address) override;
   void Compile_lwx(CompileFlags cf, MemoryAccessSize size, bool sign, bool use_fastmem,
@@ -771,6 +771,27 @@ void CPU::ARM64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, const u8
   armAsm->bind(&block_unchanged);
 }
 
+void CPU::ARM64Recompiler::GenerateTraceCountdown(u32* counter)
+{
+  armMoveAddressToReg(armAsm, RXARG1, counter);
+  armAsm->ldr(RWARG2, MemOperand(RXARG1));
+  armAsm->subs(RWARG2, RWARG2, 1);
+  armAsm->str(RWARG2, MemOperand(RXARG1));
+
+  Label not_hot;
+  armAsm->b(&not_hot, ne);
+  armEmitJmp(armAsm, CodeCache::g_discard_and_recompile_block, false);
+  armAsm->bind(&not_hot);
+}
+
+void CPU::ARM64Recompiler::GenerateProfileCounterIncrement(u64* counter)
+{
+  armMoveAddressToReg(armAsm, RXARG1, counter);
+  armAsm->ldr(RXARG2, MemOperand(RXARG1));
+  armAsm->add(RXARG2, RXARG2, 1);
+  armAsm->str(RXARG2, MemOperand(RXARG1));
+}
+
 void CPU::ARM64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -923,6 +944,11 @@ void CPU::ARM64Recompiler::EndAndLinkBlock(const std::optional<u32>& newpc, bool
   {
     armEmitJmp(armAsm, CodeCache::g_dispatcher, false);
   }
+  else if (newpc.value() == m_block->pc && IsSkippingIdleLoop())
+  {
+    EmitCall(reinterpret_cast<const void*>(&CodeCache::SkipIdleLoop));
+    armEmitJmp(armAsm, CodeCache::g_run_events_and_dispatch, false);
+  }
   else
   {
     const void* target = (newpc.value() == m_block->pc) ?
@@ -1850,6 +1876,7 @@ CPU::ARM64Recompiler::ComputeLoadStoreAddressArg(CompileFlags cf, const std::opt
 template<typename RegAllocFn>
 vixl::aarch64::Register CPU::ARM64Recompiler::GenerateLoad(const vixl::aarch64::Register& addr_reg,
                                                            MemoryAccessSize size, bool sign, bool use_fastmem,
+                                                           const void* direct_handler,
                                                            const RegAllocFn& dst_reg_alloc)
 {
   DebugAssert(addr_reg.IsW());
@@ -1892,26 +1919,34 @@ vixl::aarch64::Register CPU::ARM64Recompiler::GenerateLoad(const vixl::aarch64::
     armAsm->mov(RWARG1, addr_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::ReadMemoryByte) :
-                         reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedReadMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::ReadMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedReadMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    EmitCall(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::ReadMemoryWord) :
-                         reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedReadMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::ReadMemoryByte) :
+                           reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedReadMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::ReadMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedReadMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::ReadMemoryWord) :
+                           reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedReadMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1966,7 +2001,7 @@ vixl::aarch64::Register CPU::ARM64Recompiler::GenerateLoad(const vixl::aarch64::
 
 void CPU::ARM64Recompiler::GenerateStore(const vixl::aarch64::Register& addr_reg,
                                          const vixl::aarch64::Register& value_reg, MemoryAccessSize size,
-                                         bool use_fastmem)
+                                         bool use_fastmem, const void* direct_handler)
 {
   DebugAssert(addr_reg.IsW() && value_reg.IsW());
   if (use_fastmem)
@@ -1996,6 +2031,17 @@ void CPU::ARM64Recompiler::GenerateStore(const vixl::aarch64::Register& addr_reg
         break;
     }
     AddLoadStoreInfo(start, kInstructionSize, addr_reg.GetCode(), value_reg.GetCode(), size, false, false);
+
+    // Flag the page as modified for memory save states. Harmless if the store was backpatched to a non-RAM address.
+    if (Bus::IsRAMDirtyPageTrackingEnabled())
+    {
+      armAsm->ubfx(RWARG3, addr_reg, Bus::RAM_DIRTY_PAGE_SHIFT, std::bit_width(Bus::RAM_DIRTY_PAGE_COUNT - 1u));
+      armMoveAddressToReg(armAsm, RXSCRATCH, Bus::g_ram_dirty_pages.data());
+      armAsm->add(RXSCRATCH, RXSCRATCH, RXARG3);
+      armEmitMov(armAsm, RWARG3, 1);
+      armAsm->strb(RWARG3, MemOperand(RXSCRATCH));
+    }
+
     return;
   }
 
@@ -2005,26 +2051,34 @@ void CPU::ARM64Recompiler::GenerateStore(const vixl::aarch64::Register& addr_reg
     armAsm->mov(RWARG2, value_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::WriteMemoryByte) :
-                         reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedWriteMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::WriteMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedWriteMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    EmitCall(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::WriteMemoryWord) :
-                         reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedWriteMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::WriteMemoryByte) :
+                           reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedWriteMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::WriteMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedWriteMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&CPU::RecompilerThunks::WriteMemoryWord) :
+                           reinterpret_cast<const void*>(&CPU::RecompilerThunks::UncheckedWriteMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -2061,7 +2115,8 @@ void CPU::ARM64Recompiler::Compile_lxx(CompileFlags cf, MemoryAccessSize size, b
                                  std::optional<WRegister>();
   FlushForLoadStore(address, false, use_fastmem);
   const Register addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const Register data = GenerateLoad(addr, size, sign, use_fastmem, [this, cf]() -> Register {
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, false);
+  const Register data = GenerateLoad(addr, size, sign, use_fastmem, direct_handler, [this, cf]() -> Register {
     if (cf.MipsT() == Reg::zero)
       return RWRET;
 
@@ -2110,7 +2165,7 @@ void CPU::ARM64Recompiler::Compile_lwx(CompileFlags cf, MemoryAccessSize size, b
   }
 
   armAsm->and_(RWARG1, addr, armCheckLogicalConstant(~0x3u));
-  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RWRET; });
 
   if (inst->r.rt == Reg::zero)
   {
@@ -2188,11 +2243,12 @@ void CPU::ARM64Recompiler::Compile_lwc2(CompileFlags cf, MemoryAccessSize size,
                                  std::optional<WRegister>();
   FlushForLoadStore(address, false, use_fastmem);
   const Register addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const Register value = GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, [this, action = action]() {
-    return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
-             WRegister(AllocateTempHostReg(HR_CALLEE_SAVED)) :
-             RWRET;
-  });
+  const Register value =
+    GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, nullptr, [this, action = action]() {
+      return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
+               WRegister(AllocateTempHostReg(HR_CALLEE_SAVED)) :
+               RWRET;
+    });
 
   switch (action)
   {
@@ -2275,11 +2331,12 @@ void CPU::ARM64Recompiler::Compile_sxx(CompileFlags cf, MemoryAccessSize size, b
                                  std::optional<WRegister>();
   FlushForLoadStore(address, true, use_fastmem);
   const Register addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, true);
   const Register data = cf.valid_host_t ? CFGetRegT(cf) : RWARG2;
   if (!cf.valid_host_t)
     MoveTToReg(RWARG2, cf);
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, direct_handler);
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -2317,7 +2374,7 @@ void CPU::ARM64Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size, b
   }
 
   armAsm->and_(RWARG1, addr, armCheckLogicalConstant(~0x3u));
-  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RWRET; });
 
   armAsm->and_(RWSCRATCH, addr, 3);
   armAsm->lsl(RWSCRATCH, RWSCRATCH, 3); // *8
@@ -2352,7 +2409,7 @@ void CPU::ARM64Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size, b
     armAsm->orr(RWARG2, RWARG2, RWRET);
   }
 
-  GenerateStore(addr, RWARG2, MemoryAccessSize::Word, use_fastmem);
+  GenerateStore(addr, RWARG2, MemoryAccessSize::Word, use_fastmem, nullptr);
   FreeHostReg(addr.GetCode());
 }
 
@@ -2393,7 +2450,7 @@ void CPU::ARM64Recompiler::Compile_swc2(CompileFlags cf, MemoryAccessSize size,
     break;
   }
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, nullptr);
   if (!g_settings.gpu_pgxp_enable)
   {
     if (addr.GetCode() != RWARG1.GetCode())
@@ -557,6 +557,27 @@ void CPU::RISCV64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, const
   rvAsm->Bind(&block_unchanged);
 }
 
+void CPU::RISCV64Recompiler::GenerateTraceCountdown(u32* counter)
+{
+  rvEmitMov64(rvAsm, RARG1, RSCRATCH, static_cast<u64>(reinterpret_cast<uintptr_t>(counter)));
+  rvAsm->LW(RARG2, 0, RARG1);
+  rvAsm->ADDIW(RARG2, RARG2, -1);
+  rvAsm->SW(RARG2, 0, RARG1);
+
+  Label not_hot;
+  rvAsm->BNEZ(RARG2, &not_hot);
+  rvEmitJmp(rvAsm, CodeCache::g_discard_and_recompile_block);
+  rvAsm->Bind(&not_hot);
+}
+
+void CPU::RISCV64Recompiler::GenerateProfileCounterIncrement(u64* counter)
+{
+  rvEmitMov64(rvAsm, RARG1, RSCRATCH, static_cast<u64>(reinterpret_cast<uintptr_t>(counter)));
+  rvAsm->LD(RARG2, 0, RARG1);
+  rvAsm->ADDI(RARG2, RARG2, 1);
+  rvAsm->SD(RARG2, 0, RARG1);
+}
+
 void CPU::RISCV64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -729,6 +750,11 @@ void CPU::RISCV64Recompiler::EndAndLinkBlock(const std::optional<u32>& newpc, bo
   {
     rvEmitJmp(rvAsm, CodeCache::g_dispatcher);
   }
+  else if (newpc.value() == m_block->pc && IsSkippingIdleLoop())
+  {
+    EmitCall(reinterpret_cast<const void*>(&CodeCache::SkipIdleLoop));
+    rvEmitJmp(rvAsm, CodeCache::g_run_events_and_dispatch);
+  }
   else
   {
     const void* target =
@@ -1682,7 +1708,8 @@ biscuit::GPR CPU::RISCV64Recompiler::ComputeLoadStoreAddressArg(CompileFlags cf,
 
 template<typename RegAllocFn>
 biscuit::GPR CPU::RISCV64Recompiler::GenerateLoad(const biscuit::GPR& addr_reg, MemoryAccessSize size, bool sign,
-                                                  bool use_fastmem, const RegAllocFn& dst_reg_alloc)
+                                                  bool use_fastmem, const void* direct_handler,
+                                                  const RegAllocFn& dst_reg_alloc)
 {
   if (use_fastmem)
   {
@@ -1735,26 +1762,34 @@ biscuit::GPR CPU::RISCV64Recompiler::GenerateLoad(const biscuit::GPR& addr_reg,
     rvAsm->MV(RARG1, addr_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryByte) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    EmitCall(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryByte) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1812,7 +1847,7 @@ biscuit::GPR CPU::RISCV64Recompiler::GenerateLoad(const biscuit::GPR& addr_reg,
 }
 
 void CPU::RISCV64Recompiler::GenerateStore(const biscuit::GPR& addr_reg, const biscuit::GPR& value_reg,
-                                           MemoryAccessSize size, bool use_fastmem)
+                                           MemoryAccessSize size, bool use_fastmem, const void* direct_handler)
 {
   if (use_fastmem)
   {
@@ -1854,6 +1889,18 @@ void CPU::RISCV64Recompiler::GenerateStore(const biscuit::GPR& addr_reg, const b
     rvAsm->NOP();
 
     AddLoadStoreInfo(start, 8, addr_reg.Index(), value_reg.Index(), size, false, false);
+
+    // Flag the page as modified for memory save states. Harmless if the store was backpatched to a non-RAM address.
+    if (Bus::IsRAMDirtyPageTrackingEnabled())
+    {
+      rvAsm->SRLIW(RARG3, addr_reg, Bus::RAM_DIRTY_PAGE_SHIFT);
+      rvAsm->ANDI(RARG3, RARG3, Bus::RAM_DIRTY_PAGE_COUNT - 1);
+      rvMoveAddressToReg(rvAsm, RSCRATCH, Bus::g_ram_dirty_pages.data());
+      rvAsm->ADD(RARG3, RARG3, RSCRATCH);
+      rvAsm->ADDI(RSCRATCH, biscuit::zero, 1);
+      rvAsm->SB(RSCRATCH, 0, RARG3);
+    }
+
     return;
   }
 
@@ -1863,26 +1910,34 @@ void CPU::RISCV64Recompiler::GenerateStore(const biscuit::GPR& addr_reg, const b
     rvAsm->MV(RARG2, value_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryByte) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    EmitCall(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryByte) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        EmitCall(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1919,7 +1974,8 @@ void CPU::RISCV64Recompiler::Compile_lxx(CompileFlags cf, MemoryAccessSize size,
                                         std::optional<GPR>();
   FlushForLoadStore(address, false, use_fastmem);
   const GPR addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const GPR data = GenerateLoad(addr, size, sign, use_fastmem, [this, cf]() {
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, false);
+  const GPR data = GenerateLoad(addr, size, sign, use_fastmem, direct_handler, [this, cf]() {
     if (cf.MipsT() == Reg::zero)
       return RRET;
 
@@ -1967,7 +2023,7 @@ void CPU::RISCV64Recompiler::Compile_lwx(CompileFlags cf, MemoryAccessSize size,
   }
 
   rvAsm->ANDI(RARG1, addr, ~0x3u);
-  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RRET; });
+  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RRET; });
 
   if (inst->r.rt == Reg::zero)
   {
@@ -2044,11 +2100,12 @@ void CPU::RISCV64Recompiler::Compile_lwc2(CompileFlags cf, MemoryAccessSize size
     g_settings.gpu_pgxp_enable ? std::optional<GPR>(GPR(AllocateTempHostReg(HR_CALLEE_SAVED))) : std::optional<GPR>();
   FlushForLoadStore(address, false, use_fastmem);
   const GPR addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const GPR value = GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, [this, action = action]() {
-    return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
-             GPR(AllocateTempHostReg(HR_CALLEE_SAVED)) :
-             RRET;
-  });
+  const GPR value =
+    GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, nullptr, [this, action = action]() {
+      return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
+               GPR(AllocateTempHostReg(HR_CALLEE_SAVED)) :
+               RRET;
+    });
 
   switch (action)
   {
@@ -2130,11 +2187,12 @@ void CPU::RISCV64Recompiler::Compile_sxx(CompileFlags cf, MemoryAccessSize size,
     g_settings.gpu_pgxp_enable ? std::optional<GPR>(GPR(AllocateTempHostReg(HR_CALLEE_SAVED))) : std::optional<GPR>();
   FlushForLoadStore(address, true, use_fastmem);
   const GPR addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, true);
   const GPR data = cf.valid_host_t ? CFGetRegT(cf) : RARG2;
   if (!cf.valid_host_t)
     MoveTToReg(RARG2, cf);
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, direct_handler);
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -2172,7 +2230,7 @@ void CPU::RISCV64Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size,
   }
 
   rvAsm->ANDI(RARG1, addr, ~0x3u);
-  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RRET; });
+  GenerateLoad(RARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RRET; });
 
   rvAsm->ANDI(RSCRATCH, addr, 3);
   rvAsm->SLLIW(RSCRATCH, RSCRATCH, 3); // *8
@@ -2209,7 +2267,7 @@ void CPU::RISCV64Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size,
     rvAsm->OR(RARG2, RARG2, RRET);
   }
 
-  GenerateStore(addr, RARG2, MemoryAccessSize::Word, use_fastmem);
+  GenerateStore(addr, RARG2, MemoryAccessSize::Word, use_fastmem, nullptr);
   FreeHostReg(addr.Index());
 }
 
@@ -2250,7 +2308,7 @@ void CPU::RISCV64Recompiler::Compile_swc2(CompileFlags cf, MemoryAccessSize size
     break;
   }
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, nullptr);
 
   if (!g_settings.gpu_pgxp_enable)
   {
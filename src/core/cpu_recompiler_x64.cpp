@@ -523,6 +523,19 @@ void CPU::X64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, const u8*
   DebugAssert(size == 0);
 }
 
+void CPU::X64Recompiler::GenerateTraceCountdown(u32* counter)
+{
+  cg->mov(RXARG1, static_cast<size_t>(reinterpret_cast<uintptr_t>(counter)));
+  cg->sub(cg->dword[RXARG1], 1);
+  cg->jz(CodeCache::g_discard_and_recompile_block);
+}
+
+void CPU::X64Recompiler::GenerateProfileCounterIncrement(u64* counter)
+{
+  cg->mov(RXARG1, static_cast<size_t>(reinterpret_cast<uintptr_t>(counter)));
+  cg->add(cg->qword[RXARG1], 1);
+}
+
 void CPU::X64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -675,6 +688,11 @@ void CPU::X64Recompiler::EndAndLinkBlock(const std::optional<u32>& newpc, bool d
   {
     cg->jmp(CodeCache::g_dispatcher);
   }
+  else if (newpc.value() == m_block->pc && IsSkippingIdleLoop())
+  {
+    cg->call(reinterpret_cast<const void*>(&CodeCache::SkipIdleLoop));
+    cg->jmp(CodeCache::g_run_events_and_dispatch);
+  }
   else
   {
     const void* target = (newpc.value() == m_block->pc) ?
@@ -1632,7 +1650,8 @@ CPU::X64Recompiler::ComputeLoadStoreAddressArg(CompileFlags cf, const std::optio
 
 template<typename RegAllocFn>
 Xbyak::Reg32 CPU::X64Recompiler::GenerateLoad(const Xbyak::Reg32& addr_reg, MemoryAccessSize size, bool sign,
-                                              bool use_fastmem, const RegAllocFn& dst_reg_alloc)
+                                              bool use_fastmem, const void* direct_handler,
+                                              const RegAllocFn& dst_reg_alloc)
 {
   if (use_fastmem)
   {
@@ -1689,26 +1708,34 @@ Xbyak::Reg32 CPU::X64Recompiler::GenerateLoad(const Xbyak::Reg32& addr_reg, Memo
     cg->mov(RWARG1, addr_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryByte) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    cg->call(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryByte) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::ReadMemoryWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedReadMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1763,7 +1790,7 @@ Xbyak::Reg32 CPU::X64Recompiler::GenerateLoad(const Xbyak::Reg32& addr_reg, Memo
 }
 
 void CPU::X64Recompiler::GenerateStore(const Xbyak::Reg32& addr_reg, const Xbyak::Reg32& value_reg,
-                                       MemoryAccessSize size, bool use_fastmem)
+                                       MemoryAccessSize size, bool use_fastmem, const void* direct_handler)
 {
   if (use_fastmem)
   {
@@ -1801,6 +1828,17 @@ void CPU::X64Recompiler::GenerateStore(const Xbyak::Reg32& addr_reg, const Xbyak
 
     AddLoadStoreInfo(start, static_cast<u32>(end - start), static_cast<u32>(addr_reg.getIdx()),
                      static_cast<u32>(value_reg.getIdx()), size, false, false);
+
+    // Flag the page as modified for memory save states. Harmless if the store was backpatched to a non-RAM address.
+    if (Bus::IsRAMDirtyPageTrackingEnabled())
+    {
+      cg->mov(RWARG3, addr_reg);
+      cg->and_(RWARG3, Bus::RAM_8MB_MASK);
+      cg->shr(RWARG3, Bus::RAM_DIRTY_PAGE_SHIFT);
+      cg->mov(RXRET, reinterpret_cast<size_t>(Bus::g_ram_dirty_pages.data()));
+      cg->mov(cg->byte[RXRET + RXARG3], 1);
+    }
+
     return;
   }
 
@@ -1810,26 +1848,34 @@ void CPU::X64Recompiler::GenerateStore(const Xbyak::Reg32& addr_reg, const Xbyak
     cg->mov(RWARG2, value_reg);
 
   const bool checked = g_settings.cpu_recompiler_memory_exceptions;
-  switch (size)
+  if (direct_handler)
   {
-    case MemoryAccessSize::Byte:
-    {
-      cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryByte) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryByte));
-    }
-    break;
-    case MemoryAccessSize::HalfWord:
-    {
-      cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryHalfWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryHalfWord));
-    }
-    break;
-    case MemoryAccessSize::Word:
+    // known hardware register, skip the memory handler lookup
+    cg->call(direct_handler);
+  }
+  else
+  {
+    switch (size)
     {
-      cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryWord) :
-                         reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryWord));
+      case MemoryAccessSize::Byte:
+      {
+        cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryByte) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryByte));
+      }
+      break;
+      case MemoryAccessSize::HalfWord:
+      {
+        cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryHalfWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryHalfWord));
+      }
+      break;
+      case MemoryAccessSize::Word:
+      {
+        cg->call(checked ? reinterpret_cast<const void*>(&RecompilerThunks::WriteMemoryWord) :
+                           reinterpret_cast<const void*>(&RecompilerThunks::UncheckedWriteMemoryWord));
+      }
+      break;
     }
-    break;
   }
 
   // TODO: turn this into an asm function instead
@@ -1867,8 +1913,9 @@ void CPU::X64Recompiler::Compile_lxx(CompileFlags cf, MemoryAccessSize size, boo
                                           std::optional<Reg32>();
   FlushForLoadStore(address, false, use_fastmem);
   const Reg32 addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, false);
 
-  const Reg32 data = GenerateLoad(addr, size, sign, use_fastmem, [this, cf]() {
+  const Reg32 data = GenerateLoad(addr, size, sign, use_fastmem, direct_handler, [this, cf]() {
     if (cf.MipsT() == Reg::zero)
       return RWRET;
 
@@ -1917,7 +1964,7 @@ void CPU::X64Recompiler::Compile_lwx(CompileFlags cf, MemoryAccessSize size, boo
 
   cg->mov(RWARG1, addr);
   cg->and_(RWARG1, ~0x3u);
-  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RWRET; });
 
   if (inst->r.rt == Reg::zero)
   {
@@ -2001,11 +2048,12 @@ void CPU::X64Recompiler::Compile_lwc2(CompileFlags cf, MemoryAccessSize size, bo
                                           std::optional<Reg32>();
   FlushForLoadStore(address, false, use_fastmem);
   const Reg32 addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  const Reg32 value = GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, [this, action = action]() {
-    return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
-             Reg32(AllocateTempHostReg(HR_CALLEE_SAVED)) :
-             RWRET;
-  });
+  const Reg32 value =
+    GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, nullptr, [this, action = action]() {
+      return (action == GTERegisterAccessAction::CallHandler && g_settings.gpu_pgxp_enable) ?
+               Reg32(AllocateTempHostReg(HR_CALLEE_SAVED)) :
+               RWRET;
+    });
 
   switch (action)
   {
@@ -2085,11 +2133,12 @@ void CPU::X64Recompiler::Compile_sxx(CompileFlags cf, MemoryAccessSize size, boo
                                           std::optional<Reg32>();
   FlushForLoadStore(address, true, use_fastmem);
   const Reg32 addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
+  const void* direct_handler = GetHardwareRegisterHandler(address, size, true);
   const Reg32 data = cf.valid_host_t ? CFGetRegT(cf) : RWARG2;
   if (!cf.valid_host_t)
     MoveTToReg(RWARG2, cf);
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, size, use_fastmem, direct_handler);
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -2127,7 +2176,7 @@ void CPU::X64Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size, boo
 
   cg->mov(RWARG1, addr);
   cg->and_(RWARG1, ~0x3u);
-  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, nullptr, []() { return RWRET; });
 
   cg->mov(cg->ecx, addr);
   cg->and_(cg->ecx, 3);
@@ -2166,7 +2215,7 @@ void CPU::X64Recompiler::Compile_swx(CompileFlags cf, MemoryAccessSize size, boo
     cg->or_(RWARG2, RWRET);
   }
 
-  GenerateStore(addr, RWARG2, MemoryAccessSize::Word, use_fastmem);
+  GenerateStore(addr, RWARG2, MemoryAccessSize::Word, use_fastmem, nullptr);
   FreeHostReg(addr.getIdx());
 }
 
@@ -2205,7 +2254,7 @@ void CPU::X64Recompiler::Compile_swc2(CompileFlags cf, MemoryAccessSize size, bo
   {
     FlushForLoadStore(address, true, use_fastmem);
     const Reg32 addr = ComputeLoadStoreAddressArg(cf, address);
-    GenerateStore(addr, RWARG2, size, use_fastmem);
+    GenerateStore(addr, RWARG2, size, use_fastmem, nullptr);
     return;
   }
 
@@ -2215,7 +2264,7 @@ void CPU::X64Recompiler::Compile_swc2(CompileFlags cf, MemoryAccessSize size, bo
   FlushForLoadStore(address, true, use_fastmem);
   ComputeLoadStoreAddressArg(cf, address, addr_reg);
   cg->mov(data_backup, RWARG2);
-  GenerateStore(addr_reg, RWARG2, size, use_fastmem);
+  GenerateStore(addr_reg, RWARG2, size, use_fastmem, nullptr);
 
   Flush(FLUSH_FOR_C_CALL);
   cg->mov(RWARG3, data_backup);
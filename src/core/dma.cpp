@@ -897,6 +897,7 @@ TickCount DMA::TransferDeviceToMemory(u32 address, u32 increment, u32 word_count
 
     const u32 terminator = UINT32_C(0xFFFFFF);
     std::memcpy(&ram_pointer[address], &terminator, sizeof(terminator));
+    Bus::MarkRAMRangeDirty(address, word_count * sizeof(u32));
     return Bus::GetDMARAMTickCount(word_count);
   }
 
@@ -918,6 +919,9 @@ TickCount DMA::TransferDeviceToMemory(u32 address, u32 increment, u32 word_count
     }
   }
 
+  if (dest_pointer != s_state.transfer_buffer.data())
+    Bus::MarkRAMRangeDirty(address, increment * word_count);
+
   // Read from device.
   switch (channel)
   {
@@ -949,6 +953,7 @@ TickCount DMA::TransferDeviceToMemory(u32 address, u32 increment, u32 word_count
     for (u32 i = 0; i < word_count; i++)
     {
       std::memcpy(&ram_pointer[address], &s_state.transfer_buffer[i], sizeof(u32));
+      Bus::MarkRAMPageDirty(address);
       address = (address + increment) & mask;
     }
   }
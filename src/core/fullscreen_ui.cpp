@@ -1492,7 +1492,9 @@ void FullscreenUI::DoResume()
   }
 
   SaveStateListEntry slentry;
-  if (!InitializeSaveStateListEntryFromPath(&slentry, std::move(path), -1, false))
+  const bool valid = InitializeSaveStateListEntryFromPath(&slentry, std::move(path), -1, false);
+  System::FlushSaveStateIndex();
+  if (!valid)
     return;
 
   ClearSaveStateEntryList();
@@ -4653,6 +4655,10 @@ void FullscreenUI::DrawEmulationSettingsPage()
     bsi, FSUI_ICONVSTR(ICON_FA_WHISKEY_GLASS, "Rewind Save Slots"),
     FSUI_VSTR("How many saves will be kept for rewinding. Higher values have greater memory requirements."), "Main",
     "RewindSaveSlots", 10, 1, 10000, FSUI_CSTR("%d Frames"), rewind_enabled);
+  DrawToggleSetting(bsi, FSUI_ICONVSTR(ICON_FA_FILE_ZIPPER, "Compress Rewind States"),
+                    FSUI_VSTR("Stores older rewind states as compressed differences, allowing many more slots in the "
+                              "same amount of memory, at a small CPU cost when saving and rewinding."),
+                    "Main", "RewindCompression", false, rewind_enabled);
 
   static constexpr const std::array runahead_options = {
     FSUI_NSTR("Disabled"), FSUI_NSTR("1 Frame"),  FSUI_NSTR("2 Frames"), FSUI_NSTR("3 Frames"),
@@ -4669,6 +4675,12 @@ void FullscreenUI::DrawEmulationSettingsPage()
     FSUI_VSTR("Activates runahead when analog input changes, which significantly increases system requirements."),
     "Main", "RunaheadForAnalogInput", false, runahead_enabled);
 
+  DrawToggleSetting(
+    bsi, FSUI_ICONVSTR(ICON_FA_FORWARD_FAST, "Skip Rendering Replayed Frames"),
+    FSUI_VSTR("Discards draw commands and audio for frames that are replayed by runahead and never displayed. Greatly "
+              "reduces the cost of runahead, but may cause graphical errors in games that reuse previous frames."),
+    "Main", "RunaheadHeadlessReplay", false, runahead_enabled);
+
   TinyString rewind_summary;
   if (runahead_enabled)
   {
@@ -4680,12 +4692,14 @@ void FullscreenUI::DrawEmulationSettingsPage()
     const u32 resolution_scale = GetEffectiveUIntSetting(bsi, "GPU", "ResolutionScale", 1);
     const float rewind_frequency = GetEffectiveFloatSetting(bsi, "Main", "RewindFrequency", 10.0f);
     const s32 rewind_save_slots = GetEffectiveIntSetting(bsi, "Main", "RewindSaveSlots", 10);
+    const bool rewind_compression = GetEffectiveBoolSetting(bsi, "Main", "RewindCompression", false);
     const float duration =
       ((rewind_frequency <= std::numeric_limits<float>::epsilon()) ? (1.0f / 60.0f) : rewind_frequency) *
       static_cast<float>(rewind_save_slots);
 
     u64 ram_usage, vram_usage;
-    System::CalculateRewindMemoryUsage(rewind_save_slots, resolution_scale, &ram_usage, &vram_usage);
+    System::CalculateRewindMemoryUsage(rewind_save_slots, resolution_scale, rewind_compression, &ram_usage,
+                                       &vram_usage);
     rewind_summary.format(
       FSUI_FSTR("Rewind for {0} frames, lasting {1:.2f} seconds will require up to {2} MB of RAM and {3} MB of VRAM."),
       rewind_save_slots, duration, ram_usage / 1048576, vram_usage / 1048576);
@@ -5352,6 +5366,13 @@ void FullscreenUI::DrawGraphicsSettingsPage()
     FSUI_NSTR("16x"),
   };
 
+  static constexpr const std::array software_renderer_scales = {
+    FSUI_NSTR("1x"),
+    FSUI_NSTR("2x"),
+    FSUI_NSTR("4x"),
+  };
+  static constexpr const std::array software_renderer_scale_values = {1, 2, 4};
+
   SettingsInterface* bsi = GetEditingSettingsInterface();
   const bool game_settings = IsEditingGameSettings(bsi);
   const u32 resolution_scale = GetEffectiveUIntSetting(bsi, "GPU", "ResolutionScale", 1);
@@ -5686,6 +5707,16 @@ void FullscreenUI::DrawGraphicsSettingsPage()
                               "particularly with the software renderer, and is safe to use."),
                     "GPU", "UseThread", true);
 
+  DrawIntRangeSetting(bsi, FSUI_ICONVSTR(ICON_FA_MICROCHIP, "Software Renderer Threads"),
+                      FSUI_VSTR("Splits the software renderer's drawing area into horizontal bands, which are drawn on "
+                                "this many threads. Set to 0 to draw everything on the GPU thread."),
+                      "GPU", "SoftwareRendererThreads", 0, 0, 32, "%d", !is_hardware);
+
+  DrawIntListSetting(bsi, FSUI_ICONVSTR(ICON_FA_EXPAND, "Software Renderer Scale"),
+                     FSUI_VSTR("Draws the software renderer's output at a multiple of the native resolution."), "GPU",
+                     "SoftwareRendererScale", 1, software_renderer_scales, true, software_renderer_scale_values,
+                     !is_hardware);
+
   DrawToggleSetting(bsi, FSUI_ICONVSTR(ICON_FA_ARROWS_UP_DOWN_LEFT_RIGHT, "Automatically Resize Window"),
                     FSUI_VSTR("Automatically resizes the window to match the internal resolution."), "Display",
                     "AutoResizeWindow", false);
@@ -6726,6 +6757,15 @@ void FullscreenUI::DrawAdvancedSettingsPage()
                   "SaveStateCompression", Settings::DEFAULT_SAVE_STATE_COMPRESSION_MODE,
                   &Settings::ParseSaveStateCompressionModeName, &Settings::GetSaveStateCompressionModeName,
                   &Settings::GetSaveStateCompressionModeDisplayName, SaveStateCompressionMode::Count);
+  DrawToggleSetting(
+    bsi, FSUI_VSTR("Deduplicate Save States"),
+    FSUI_VSTR("Stores save state data in shared chunks, so identical data across slots is only saved once."), "Main",
+    "SaveStateDeduplication", false);
+  DrawEnumSetting(bsi, FSUI_VSTR("Rewind/Runahead Snapshot Mode"),
+                  FSUI_VSTR("Determines how modified memory is found when saving rewind and runahead states."), "Main",
+                  "MemorySaveStateSnapshot", Settings::DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE,
+                  &Settings::ParseMemorySaveStateSnapshotModeName, &Settings::GetMemorySaveStateSnapshotModeName,
+                  &Settings::GetMemorySaveStateSnapshotModeDisplayName, MemorySaveStateSnapshotMode::Count);
 
   MenuHeading(FSUI_VSTR("CPU Emulation"));
 
@@ -6736,6 +6776,19 @@ void FullscreenUI::DrawAdvancedSettingsPage()
     bsi, FSUI_VSTR("Enable Recompiler Block Linking"),
     FSUI_VSTR("Performance enhancement - jumps directly between blocks instead of returning to the dispatcher."), "CPU",
     "RecompilerBlockLinking", true);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Block Cache"),
+                    FSUI_VSTR("Stores analysed blocks on disk for each game, so they don't have to be analysed again."),
+                    "CPU", "RecompilerBlockCache", false);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Traces"),
+                    FSUI_VSTR("Recompiles frequently executed blocks together with the blocks they jump to."), "CPU",
+                    "RecompilerTraces", false);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Block Profiling"),
+                    FSUI_VSTR("Counts executions of each block, and writes a report to the profiles directory on "
+                              "shutdown."),
+                    "CPU", "RecompilerBlockProfiling", false);
+  DrawToggleSetting(bsi, FSUI_VSTR("Skip Recompiler Idle Loops"),
+                    FSUI_VSTR("Fast forwards loops which wait for an interrupt or memory to change to the next event."),
+                    "CPU", "RecompilerIdleLoopSkipping", false);
   DrawEnumSetting(bsi, FSUI_VSTR("Recompiler Fast Memory Access"),
                   FSUI_VSTR("Avoids calls to C++ code, significantly speeding up the recompiler."), "CPU",
                   "FastmemMode", Settings::DEFAULT_CPU_FASTMEM_MODE, &Settings::ParseCPUFastmemMode,
@@ -7393,6 +7446,7 @@ u32 FullscreenUI::PopulateSaveStateListEntries(const std::string& serial,
       s_state.save_state_selector_slots.push_back(std::move(li));
   }
 
+  System::FlushSaveStateIndex();
   return static_cast<u32>(s_state.save_state_selector_slots.size());
 }
 
@@ -7737,7 +7791,9 @@ void FullscreenUI::DrawSaveStateSelector()
 bool FullscreenUI::OpenLoadStateSelectorForGameResume(const GameList::Entry* entry)
 {
   SaveStateListEntry slentry;
-  if (!InitializeSaveStateListEntryFromSerial(&slentry, entry->serial, -1, false))
+  const bool valid = InitializeSaveStateListEntryFromSerial(&slentry, entry->serial, -1, false);
+  System::FlushSaveStateIndex();
+  if (!valid)
     return false;
 
   slentry.game_path = entry->path;
@@ -9650,6 +9706,7 @@ TRANSLATE_NOOP("FullscreenUI", "Cobalt Sky");
 TRANSLATE_NOOP("FullscreenUI", "Compatibility Rating");
 TRANSLATE_NOOP("FullscreenUI", "Compatibility: ");
 TRANSLATE_NOOP("FullscreenUI", "Completely exits the application, returning you to your desktop.");
+TRANSLATE_NOOP("FullscreenUI", "Compress Rewind States");
 TRANSLATE_NOOP("FullscreenUI", "Configuration");
 TRANSLATE_NOOP("FullscreenUI", "Confirm Power Off");
 TRANSLATE_NOOP("FullscreenUI", "Console Settings");
@@ -9673,6 +9730,7 @@ TRANSLATE_NOOP("FullscreenUI", "Copies the global controller configuration to th
 TRANSLATE_NOOP("FullscreenUI", "Copy Global Settings");
 TRANSLATE_NOOP("FullscreenUI", "Copy Settings");
 TRANSLATE_NOOP("FullscreenUI", "Could not find any CD/DVD-ROM devices. Please ensure you have a drive connected and sufficient permissions to access it.");
+TRANSLATE_NOOP("FullscreenUI", "Counts executions of each block, and writes a report to the profiles directory on shutdown.");
 TRANSLATE_NOOP("FullscreenUI", "Cover Downloader");
 TRANSLATE_NOOP("FullscreenUI", "Cover Settings");
 TRANSLATE_NOOP("FullscreenUI", "Cover set.");
@@ -9687,6 +9745,7 @@ TRANSLATE_NOOP("FullscreenUI", "Dark");
 TRANSLATE_NOOP("FullscreenUI", "Dark Ruby");
 TRANSLATE_NOOP("FullscreenUI", "Deadzone");
 TRANSLATE_NOOP("FullscreenUI", "Debugging Settings");
+TRANSLATE_NOOP("FullscreenUI", "Deduplicate Save States");
 TRANSLATE_NOOP("FullscreenUI", "Default");
 TRANSLATE_NOOP("FullscreenUI", "Default Boot");
 TRANSLATE_NOOP("FullscreenUI", "Default Value");
@@ -9703,6 +9762,7 @@ TRANSLATE_NOOP("FullscreenUI", "Destination Alpha Blending");
 TRANSLATE_NOOP("FullscreenUI", "Details");
 TRANSLATE_NOOP("FullscreenUI", "Details unavailable for game not scanned in game list.");
 TRANSLATE_NOOP("FullscreenUI", "Determines how large the on-screen messages and monitor are.");
+TRANSLATE_NOOP("FullscreenUI", "Determines how modified memory is found when saving rewind and runahead states.");
 TRANSLATE_NOOP("FullscreenUI", "Determines how much button pressure is ignored before activating the macro.");
 TRANSLATE_NOOP("FullscreenUI", "Determines how much latency there is between the audio being picked up by the host API, and played through speakers.");
 TRANSLATE_NOOP("FullscreenUI", "Determines how much of the area typically not visible on a consumer TV set to crop/hide.");
@@ -9730,6 +9790,7 @@ TRANSLATE_NOOP("FullscreenUI", "Disable Subdirectory Scanning");
 TRANSLATE_NOOP("FullscreenUI", "Disable on 2D Polygons");
 TRANSLATE_NOOP("FullscreenUI", "Disabled");
 TRANSLATE_NOOP("FullscreenUI", "Disc");
+TRANSLATE_NOOP("FullscreenUI", "Discards draw commands and audio for frames that are replayed by runahead and never displayed. Greatly reduces the cost of runahead, but may cause graphical errors in games that reuse previous frames.");
 TRANSLATE_NOOP("FullscreenUI", "Discord Server");
 TRANSLATE_NOOP("FullscreenUI", "Display Area");
 TRANSLATE_NOOP("FullscreenUI", "Displays DualShock/DualSense button icons in the footer and input binding, instead of Xbox buttons.");
@@ -9745,6 +9806,7 @@ TRANSLATE_NOOP("FullscreenUI", "Downsamples the rendered image prior to displayi
 TRANSLATE_NOOP("FullscreenUI", "Downsampling");
 TRANSLATE_NOOP("FullscreenUI", "Downsampling Display Scale");
 TRANSLATE_NOOP("FullscreenUI", "Draws a border around the currently-selected item for readability.");
+TRANSLATE_NOOP("FullscreenUI", "Draws the software renderer's output at a multiple of the native resolution.");
 TRANSLATE_NOOP("FullscreenUI", "Duck icon by icons8 (https://icons8.com/icon/74847/platforms.undefined.short-title)");
 TRANSLATE_NOOP("FullscreenUI", "DuckStation can automatically download covers for games which do not currently have a cover set. We do not host any cover images, the user must provide their own source for images.");
 TRANSLATE_NOOP("FullscreenUI", "DuckStation is a free simulator/emulator of the Sony PlayStation(TM) console, focusing on playability, speed, and long-term maintainability.");
@@ -9762,9 +9824,12 @@ TRANSLATE_NOOP("FullscreenUI", "Enable GPU-Based Validation");
 TRANSLATE_NOOP("FullscreenUI", "Enable GPU-based validation when supported by the host's renderer API. Only for developer use.");
 TRANSLATE_NOOP("FullscreenUI", "Enable Overclocking");
 TRANSLATE_NOOP("FullscreenUI", "Enable Post Processing");
+TRANSLATE_NOOP("FullscreenUI", "Enable Recompiler Block Cache");
 TRANSLATE_NOOP("FullscreenUI", "Enable Recompiler Block Linking");
+TRANSLATE_NOOP("FullscreenUI", "Enable Recompiler Block Profiling");
 TRANSLATE_NOOP("FullscreenUI", "Enable Recompiler ICache");
 TRANSLATE_NOOP("FullscreenUI", "Enable Recompiler Memory Exceptions");
+TRANSLATE_NOOP("FullscreenUI", "Enable Recompiler Traces");
 TRANSLATE_NOOP("FullscreenUI", "Enable Region Check");
 TRANSLATE_NOOP("FullscreenUI", "Enable Rewinding");
 TRANSLATE_NOOP("FullscreenUI", "Enable SDL Input Source");
@@ -9818,6 +9883,7 @@ TRANSLATE_NOOP("FullscreenUI", "Fast Forward Boot");
 TRANSLATE_NOOP("FullscreenUI", "Fast Forward Memory Card Access");
 TRANSLATE_NOOP("FullscreenUI", "Fast Forward Speed");
 TRANSLATE_NOOP("FullscreenUI", "Fast Forward Volume");
+TRANSLATE_NOOP("FullscreenUI", "Fast forwards loops which wait for an interrupt or memory to change to the next event.");
 TRANSLATE_NOOP("FullscreenUI", "Fast forwards through memory card access, both loading and saving. Can reduce waiting times in games that frequently access memory cards.");
 TRANSLATE_NOOP("FullscreenUI", "Fast forwards through the early loading process when fast booting, saving time. Results may vary between games.");
 TRANSLATE_NOOP("FullscreenUI", "File Size");
@@ -10018,6 +10084,7 @@ TRANSLATE_NOOP("FullscreenUI", "Quick Save");
 TRANSLATE_NOOP("FullscreenUI", "Read Speedup");
 TRANSLATE_NOOP("FullscreenUI", "Readahead Sectors");
 TRANSLATE_NOOP("FullscreenUI", "Recompiler Fast Memory Access");
+TRANSLATE_NOOP("FullscreenUI", "Recompiles frequently executed blocks together with the blocks they jump to.");
 TRANSLATE_NOOP("FullscreenUI", "Reduce Input Latency");
 TRANSLATE_NOOP("FullscreenUI", "Reduces \"wobbly\" polygons by attempting to preserve the fractional component through memory transfers.");
 TRANSLATE_NOOP("FullscreenUI", "Reduces hitches in emulation by reading/decompressing CD data asynchronously on a worker thread.");
@@ -10060,6 +10127,7 @@ TRANSLATE_NOOP("FullscreenUI", "Rewind Save Slots");
 TRANSLATE_NOOP("FullscreenUI", "Rewind for {0} frames, lasting {1:.2f} seconds will require up to {2} MB of RAM and {3} MB of VRAM.");
 TRANSLATE_NOOP("FullscreenUI", "Rewind is disabled because runahead is enabled. Runahead will significantly increase system requirements.");
 TRANSLATE_NOOP("FullscreenUI", "Rewind is not enabled. Please note that enabling rewind may significantly increase system requirements.");
+TRANSLATE_NOOP("FullscreenUI", "Rewind/Runahead Snapshot Mode");
 TRANSLATE_NOOP("FullscreenUI", "Right: ");
 TRANSLATE_NOOP("FullscreenUI", "Round Upscaled Texture Coordinates");
 TRANSLATE_NOOP("FullscreenUI", "Rounds texture coordinates instead of flooring when upscaling. Can fix misaligned textures in some games, but break others, and is incompatible with texture filtering.");
@@ -10169,12 +10237,16 @@ TRANSLATE_NOOP("FullscreenUI", "Simulates the region check present in original,
 TRANSLATE_NOOP("FullscreenUI", "Simulates the system ahead of time and rolls back/replays to reduce input lag. Very high system requirements.");
 TRANSLATE_NOOP("FullscreenUI", "Size: ");
 TRANSLATE_NOOP("FullscreenUI", "Skip Duplicate Frame Display");
+TRANSLATE_NOOP("FullscreenUI", "Skip Recompiler Idle Loops");
+TRANSLATE_NOOP("FullscreenUI", "Skip Rendering Replayed Frames");
 TRANSLATE_NOOP("FullscreenUI", "Skips the presentation/display of frames that are not unique. Can result in worse frame pacing.");
 TRANSLATE_NOOP("FullscreenUI", "Slow Boot");
 TRANSLATE_NOOP("FullscreenUI", "Smooth Scrolling");
 TRANSLATE_NOOP("FullscreenUI", "Smooths out blockyness between colour transitions in 24-bit content, usually FMVs.");
 TRANSLATE_NOOP("FullscreenUI", "Smooths out the blockiness of magnified textures on 2D objects.");
 TRANSLATE_NOOP("FullscreenUI", "Smooths out the blockiness of magnified textures on 3D objects.");
+TRANSLATE_NOOP("FullscreenUI", "Software Renderer Scale");
+TRANSLATE_NOOP("FullscreenUI", "Software Renderer Threads");
 TRANSLATE_NOOP("FullscreenUI", "Sort Alphabetically");
 TRANSLATE_NOOP("FullscreenUI", "Sort By");
 TRANSLATE_NOOP("FullscreenUI", "Sort Reversed");
@@ -10185,6 +10257,7 @@ TRANSLATE_NOOP("FullscreenUI", "Spectator Mode");
 TRANSLATE_NOOP("FullscreenUI", "Speed Control");
 TRANSLATE_NOOP("FullscreenUI", "Speeds up CD-ROM reads by the specified factor. May improve loading speeds in some games, and break others.");
 TRANSLATE_NOOP("FullscreenUI", "Speeds up CD-ROM seeks by the specified factor. May improve loading speeds in some games, and break others.");
+TRANSLATE_NOOP("FullscreenUI", "Splits the software renderer's drawing area into horizontal bands, which are drawn on this many threads. Set to 0 to draw everything on the GPU thread.");
 TRANSLATE_NOOP("FullscreenUI", "Sprite Texture Filtering");
 TRANSLATE_NOOP("FullscreenUI", "Stage {}: {}");
 TRANSLATE_NOOP("FullscreenUI", "Start BIOS");
@@ -10195,6 +10268,9 @@ TRANSLATE_NOOP("FullscreenUI", "Start Fullscreen");
 TRANSLATE_NOOP("FullscreenUI", "Start Game");
 TRANSLATE_NOOP("FullscreenUI", "Start a game from a disc in your PC's DVD drive.");
 TRANSLATE_NOOP("FullscreenUI", "Start the console without any disc inserted.");
+TRANSLATE_NOOP("FullscreenUI", "Stores analysed blocks on disk for each game, so they don't have to be analysed again.");
+TRANSLATE_NOOP("FullscreenUI", "Stores older rewind states as compressed differences, allowing many more slots in the same amount of memory, at a small CPU cost when saving and rewinding.");
+TRANSLATE_NOOP("FullscreenUI", "Stores save state data in shared chunks, so identical data across slots is only saved once.");
 TRANSLATE_NOOP("FullscreenUI", "Stores the current settings to a controller preset.");
 TRANSLATE_NOOP("FullscreenUI", "Stretch Mode");
 TRANSLATE_NOOP("FullscreenUI", "Summary");
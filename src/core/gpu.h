@@ -230,6 +230,10 @@ public:
   // Queues the current frame for presentation. Should only be used with runahead.
   void QueuePresentCurrentFrame();
 
+  // Drops draw commands instead of sending them to the backend. VRAM fills/writes/copies are still sent.
+  // Used by runahead for replayed frames which will never be displayed.
+  ALWAYS_INLINE void SetDiscardDrawCommands(bool discard) { m_discard_draw_commands = discard; }
+
   /// Computes the effective resolution scale when it is set to automatic.
   u8 CalculateAutomaticResolutionScale() const;
 
@@ -312,6 +316,7 @@ private:
   void UpdateVRAM(u16 x, u16 y, u16 width, u16 height, const void* data, bool set_mask, bool check_mask);
 
   void PrepareForDraw();
+  void PushDrawCommand(GPUBackendDrawCommand* cmd);
   void FinishPolyline();
   void FillDrawCommand(GPUBackendDrawCommand* RESTRICT cmd, GPURenderCommand rc) const;
 
@@ -436,6 +441,7 @@ private:
   bool m_set_texture_disable_mask = false;
   bool m_drawing_area_changed = false;
   bool m_force_progressive_scan = false;
+  bool m_discard_draw_commands = false;
   ForceVideoTimingMode m_force_frame_timings = ForceVideoTimingMode::Disabled;
 
   struct CRTCState
@@ -22,6 +22,7 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/threading.h"
+#include "common/timer.h"
 
 #include "IconsEmoji.h"
 #include "IconsFontAwesome6.h"
@@ -122,6 +123,15 @@ void GPUBackend::UpdatePostProcessingSettings(bool force_reload)
 {
 }
 
+void GPUBackend::OnCommandFIFOEmpty()
+{
+}
+
+void GPUBackend::UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit)
+{
+  GPU_SW_Rasterizer::UpdateCLUT(reg, clut_is_8bit);
+}
+
 GPUThreadCommand* GPUBackend::NewClearVRAMCommand()
 {
   return static_cast<GPUThreadCommand*>(
@@ -396,18 +406,26 @@ void GPUBackend::HandleCommand(const GPUThreadCommand* cmd)
 
     case GPUBackendCommandType::LoadMemoryState:
     {
+      const Timer::Value start_time = Timer::GetCurrentValue();
       System::MemorySaveState& mss = *static_cast<const GPUBackendDoMemoryStateCommand*>(cmd)->memory_save_state;
       StateWrapper sw(mss.gpu_state_data.span(0, mss.gpu_state_size), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
       DoMemoryState(sw, mss);
+      PerformanceCounters::AccumulateMemorySaveStateComponent(PerformanceCounters::MemorySaveStateComponent::GPUBackend,
+                                                              true, Timer::GetCurrentValue() - start_time,
+                                                              sw.GetPosition());
     }
     break;
 
     case GPUBackendCommandType::SaveMemoryState:
     {
+      const Timer::Value start_time = Timer::GetCurrentValue();
       System::MemorySaveState& mss = *static_cast<const GPUBackendDoMemoryStateCommand*>(cmd)->memory_save_state;
       StateWrapper sw(mss.gpu_state_data.span(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
       DoMemoryState(sw, mss);
       mss.gpu_state_size = static_cast<u32>(sw.GetPosition());
+      PerformanceCounters::AccumulateMemorySaveStateComponent(PerformanceCounters::MemorySaveStateComponent::GPUBackend,
+                                                              false, Timer::GetCurrentValue() - start_time,
+                                                              mss.gpu_state_size);
     }
     break;
 
@@ -488,7 +506,7 @@ void GPUBackend::HandleCommand(const GPUThreadCommand* cmd)
     case GPUBackendCommandType::UpdateCLUT:
     {
       const GPUBackendUpdateCLUTCommand* ccmd = static_cast<const GPUBackendUpdateCLUTCommand*>(cmd);
-      GPU_SW_Rasterizer::UpdateCLUT(ccmd->reg, ccmd->clut_is_8bit);
+      UpdateCLUT(ccmd->reg, ccmd->clut_is_8bit);
     }
     break;
 
@@ -91,6 +91,10 @@ public:
   /// Ensures all pending draws are flushed to the host GPU.
   virtual void FlushRender() = 0;
 
+  /// Called on the GPU thread when there are no more commands to execute, before the CPU thread is allowed to observe
+  /// VRAM. Backends which render on other threads must finish here.
+  virtual void OnCommandFIFOEmpty();
+
   /// Main command handler for GPU thread.
   void HandleCommand(const GPUThreadCommand* cmd);
 
@@ -161,6 +165,7 @@ protected:
   virtual void DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd) = 0;
 
   virtual void DrawingAreaChanged() = 0;
+  virtual void UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit);
   virtual void ClearCache() = 0;
   virtual void OnBufferSwapped() = 0;
   virtual void ClearVRAM() = 0;
@@ -325,6 +325,15 @@ void GPU::PrepareForDraw()
   }
 }
 
+ALWAYS_INLINE_RELEASE void GPU::PushDrawCommand(GPUBackendDrawCommand* cmd)
+{
+  // Commands are only committed to the FIFO on push, so the next allocation reuses the space of a dropped command.
+  if (m_discard_draw_commands) [[unlikely]]
+    return;
+
+  GPUBackend::PushCommand(cmd);
+}
+
 void GPU::FillDrawCommand(GPUBackendDrawCommand* RESTRICT cmd, GPURenderCommand rc) const
 {
   cmd->interlaced_rendering = IsInterlacedRenderingEnabled();
@@ -504,7 +513,7 @@ bool GPU::HandleRenderPolygonCommand()
       }
     }
 
-    GPUBackend::PushCommand(cmd);
+    PushDrawCommand(cmd);
   }
   else
   {
@@ -595,7 +604,7 @@ bool GPU::HandleRenderPolygonCommand()
       }
     }
 
-    GPUBackend::PushCommand(cmd);
+    PushDrawCommand(cmd);
   }
 
   EndCommand();
@@ -676,7 +685,7 @@ bool GPU::HandleRenderRectangleCommand()
   const GSVector4i rect = GSVector4i(cmd->x, cmd->y, cmd->x + cmd->width, cmd->y + cmd->height);
   AddDrawRectangleTicks(rect, rc.texture_enable, rc.transparency_enable);
 
-  GPUBackend::PushCommand(cmd);
+  PushDrawCommand(cmd);
   EndCommand();
   return true;
 }
@@ -735,7 +744,7 @@ bool GPU::HandleRenderLineCommand()
     }
 
     AddDrawLineTicks(rect, rc.shading_enable);
-    GPUBackend::PushCommand(cmd);
+    PushDrawCommand(cmd);
   }
   else
   {
@@ -780,7 +789,7 @@ bool GPU::HandleRenderLineCommand()
     }
 
     AddDrawLineTicks(rect, rc.shading_enable);
-    GPUBackend::PushCommand(cmd);
+    PushDrawCommand(cmd);
   }
 
   EndCommand();
@@ -880,7 +889,7 @@ void GPU::FinishPolyline()
     {
       DebugAssert(out_vertex_count <= cmd->num_vertices);
       cmd->num_vertices = Truncate16(out_vertex_count);
-      GPUBackend::PushCommand(cmd);
+      PushDrawCommand(cmd);
     }
   }
   else
@@ -931,7 +940,7 @@ void GPU::FinishPolyline()
     {
       DebugAssert(out_vertex_count <= cmd->num_vertices);
       cmd->num_vertices = Truncate16(out_vertex_count);
-      GPUBackend::PushCommand(cmd);
+      PushDrawCommand(cmd);
     }
   }
 }
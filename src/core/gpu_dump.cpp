@@ -101,12 +101,14 @@ bool GPUDump::Recorder::Compress(const std::string& source_path, GPUDumpCompress
   if (!data)
     return false;
 
+  // dumps are usually hundreds of megabytes, so every mode benefits from multiple threads
+  const u32 num_workers = CompressHelpers::GetDefaultWorkerCount();
   if (mode >= GPUDumpCompressionMode::ZstLow && mode <= GPUDumpCompressionMode::ZstHigh)
   {
     const int clevel =
       ((mode == GPUDumpCompressionMode::ZstLow) ? 1 : ((mode == GPUDumpCompressionMode::ZstHigh) ? 19 : 0));
     if (!CompressHelpers::CompressToFile(fmt::format("{}.zst", source_path).c_str(), std::move(data.value()), clevel,
-                                         true, error))
+                                         num_workers, true, error))
     {
       return false;
     }
@@ -114,9 +116,9 @@ bool GPUDump::Recorder::Compress(const std::string& source_path, GPUDumpCompress
   else if (mode >= GPUDumpCompressionMode::XZLow && mode <= GPUDumpCompressionMode::XZHigh)
   {
     const int clevel =
-      ((mode == GPUDumpCompressionMode::XZLow) ? 3 : ((mode == GPUDumpCompressionMode::ZstHigh) ? 9 : 5));
+      ((mode == GPUDumpCompressionMode::XZLow) ? 3 : ((mode == GPUDumpCompressionMode::XZHigh) ? 9 : 5));
     if (!CompressHelpers::CompressToFile(fmt::format("{}.xz", source_path).c_str(), std::move(data.value()), clevel,
-                                         true, error))
+                                         num_workers, true, error))
     {
       return false;
     }
@@ -18,18 +18,74 @@
 #include "common/log.h"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <utility>
 
 LOG_CHANNEL(GPU);
 
+/// Computes the area affected by a VRAM transfer, including wrap-around of X.
+ALWAYS_INLINE_RELEASE static GSVector4i GetVRAMTransferBounds(u32 x, u32 y, u32 width, u32 height)
+{
+  GSVector4i ret;
+  ret.left = x % VRAM_WIDTH;
+  ret.top = y % VRAM_HEIGHT;
+  ret.right = ret.left + width;
+  ret.bottom = ret.top + height;
+  if (ret.right > static_cast<s32>(VRAM_WIDTH))
+  {
+    ret.left = 0;
+    ret.right = static_cast<s32>(VRAM_WIDTH);
+  }
+  if (ret.bottom > static_cast<s32>(VRAM_HEIGHT))
+  {
+    ret.top = 0;
+    ret.bottom = static_cast<s32>(VRAM_HEIGHT);
+  }
+  return ret;
+}
+
+/// Computes the area which can be touched by a primitive with the specified vertex extents. Positions are truncated to
+/// 11 bits when rasterizing, so primitives outside that range could wrap around to anywhere.
+ALWAYS_INLINE_RELEASE static GSVector4i GetPrimitiveBounds(s32 min_x, s32 min_y, s32 max_x, s32 max_y)
+{
+  if (min_x < -1024 || min_y < -1024 || max_x > 1023 || max_y > 1023) [[unlikely]]
+    return GSVector4i::cxpr(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+
+  return GSVector4i(min_x, min_y, max_x + 1, max_y + 1);
+}
+
+/// Scales a precise vertex position for upscaling, unless it's far enough from the native position to be a different
+/// vertex, since the bounds of the primitive are computed from the native positions.
+ALWAYS_INLINE_RELEASE static s32 GetScaledPrecisePosition(float precise_pos, s32 native_pos, s32 scale)
+{
+  if (!(std::abs(precise_pos - static_cast<float>(native_pos)) <= 1.0f)) [[unlikely]]
+    return native_pos * scale;
+
+  return static_cast<s32>(std::floor(precise_pos * static_cast<float>(scale) + 0.5f));
+}
+
+/// Bands are split from the rows of the drawing area, which only works if drawing can't wrap around VRAM.
+ALWAYS_INLINE static bool IsBinnableDrawingArea(const GPUDrawingArea& area)
+{
+  return (area.right < VRAM_WIDTH && area.bottom < VRAM_HEIGHT);
+}
+
 GPU_SW::GPU_SW(GPUPresenter& presenter) : GPUBackend(presenter)
 {
 }
 
-GPU_SW::~GPU_SW() = default;
+GPU_SW::~GPU_SW()
+{
+  FlushBinnedCommands();
+  GPU_SW_Rasterizer::g_scaled_vram = nullptr;
+  GPU_SW_Rasterizer::g_scaled_vram_shift = 0;
+}
 
 u32 GPU_SW::GetResolutionScale() const
 {
-  return 1u;
+  return (1u << m_scale_shift);
 }
 
 bool GPU_SW::Initialize(bool upload_vram, Error* error)
@@ -56,19 +112,40 @@ bool GPU_SW::Initialize(bool upload_vram, Error* error)
   if (!upload_vram)
     std::memset(g_vram, 0, sizeof(g_vram));
 
+  UpdateBandThreads();
+  UpdateResolutionScale();
+  return true;
+}
+
+bool GPU_SW::UpdateSettings(const GPUSettings& old_settings, Error* error)
+{
+  if (!GPUBackend::UpdateSettings(old_settings, error))
+    return false;
+
+  if (g_gpu_settings.gpu_software_renderer_threads != old_settings.gpu_software_renderer_threads)
+    UpdateBandThreads();
+  if (g_gpu_settings.gpu_software_renderer_scale != old_settings.gpu_software_renderer_scale)
+    UpdateResolutionScale();
+
   return true;
 }
 
 void GPU_SW::ClearVRAM()
 {
+  FlushBinnedCommands();
   std::memset(g_vram, 0, sizeof(g_vram));
   std::memset(g_gpu_clut, 0, sizeof(g_gpu_clut));
+  if (m_scale_shift > 0)
+    m_scaled_vram.fill(0);
 }
 
 void GPU_SW::LoadState(const GPUBackendLoadStateCommand* cmd)
 {
+  FlushBinnedCommands();
   std::memcpy(g_vram, cmd->vram_data, sizeof(g_vram));
   std::memcpy(g_gpu_clut, cmd->clut_data, sizeof(g_gpu_clut));
+  if (m_scale_shift > 0)
+    UpdateScaledVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
 }
 
 bool GPU_SW::AllocateMemorySaveState(System::MemorySaveState& mss, Error* error)
@@ -79,28 +156,58 @@ bool GPU_SW::AllocateMemorySaveState(System::MemorySaveState& mss, Error* error)
 
 void GPU_SW::DoMemoryState(StateWrapper& sw, System::MemorySaveState& mss)
 {
+  FlushBinnedCommands();
   sw.DoBytes(g_vram, sizeof(g_vram));
   sw.DoBytes(g_gpu_clut, sizeof(g_gpu_clut));
   DebugAssert(!sw.HasError());
+
+  // Only native VRAM is saved, so the upscaled detail is lost when rewinding.
+  if (sw.IsReading() && m_scale_shift > 0)
+    UpdateScaledVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
 }
 
 void GPU_SW::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
+  FlushBinnedCommands();
 }
 
 void GPU_SW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, bool interlaced_rendering, u8 active_line_lsb)
 {
+  SyncBinnedCommands(INVALID_RECT, GetVRAMTransferBounds(x, y, width, height));
   GPU_SW_Rasterizer::FillVRAM(x, y, width, height, color, interlaced_rendering, active_line_lsb);
+
+  if (m_scale_shift > 0)
+  {
+    if (!interlaced_rendering)
+    {
+      UpdateScaledVRAM(x, y, width, height);
+    }
+    else
+    {
+      for (u32 row = 0; row < height; row++)
+      {
+        if (((y + row) & 1u) != active_line_lsb)
+          UpdateScaledVRAM(x, y + row, width, 1);
+      }
+    }
+  }
 }
 
 void GPU_SW::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask)
 {
+  SyncBinnedCommands(INVALID_RECT, GetVRAMTransferBounds(x, y, width, height));
   GPU_SW_Rasterizer::WriteVRAM(x, y, width, height, data, set_mask, check_mask);
+  if (m_scale_shift > 0)
+    UpdateScaledVRAM(x, y, width, height);
 }
 
 void GPU_SW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask, bool check_mask)
 {
+  SyncBinnedCommands(GetVRAMTransferBounds(src_x, src_y, width, height),
+                     GetVRAMTransferBounds(dst_x, dst_y, width, height));
   GPU_SW_Rasterizer::CopyVRAM(src_x, src_y, dst_x, dst_y, width, height, set_mask, check_mask);
+  if (m_scale_shift > 0)
+    CopyScaledVRAM(src_x, src_y, dst_x, dst_y, width, height, set_mask, check_mask);
 }
 
 void GPU_SW::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
@@ -108,9 +215,29 @@ void GPU_SW::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
   const GPU_SW_Rasterizer::DrawTriangleFunction DrawFunction = GPU_SW_Rasterizer::GetDrawTriangleFunction(
     cmd->shading_enable, cmd->texture_enable, cmd->raw_texture_enable, cmd->transparency_enable);
 
-  DrawFunction(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
+  GPU_SW_Rasterizer::DrawTriangleFunction ScaledDrawFunction = nullptr;
+  GPUBackendDrawPolygonCommand::Vertex scaled_vertices[4];
+  if (m_scale_shift > 0)
+  {
+    ScaledDrawFunction = GPU_SW_Rasterizer::GetScaledDrawTriangleFunction(
+      cmd->shading_enable, cmd->texture_enable, cmd->raw_texture_enable, cmd->transparency_enable);
+
+    const s32 scale = 1 << m_scale_shift;
+    for (u32 i = 0; i < cmd->num_vertices; i++)
+    {
+      scaled_vertices[i] = cmd->vertices[i];
+      scaled_vertices[i].x = cmd->vertices[i].x * scale;
+      scaled_vertices[i].y = cmd->vertices[i].y * scale;
+    }
+  }
+
+  DrawTriangle(DrawFunction, ScaledDrawFunction, cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2],
+               &scaled_vertices[0], &scaled_vertices[1], &scaled_vertices[2]);
   if (cmd->num_vertices > 3)
-    DrawFunction(cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
+  {
+    DrawTriangle(DrawFunction, ScaledDrawFunction, cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3],
+                 &scaled_vertices[2], &scaled_vertices[1], &scaled_vertices[3]);
+  }
 }
 
 void GPU_SW::DrawPrecisePolygon(const GPUBackendDrawPrecisePolygonCommand* cmd)
@@ -128,9 +255,31 @@ void GPU_SW::DrawPrecisePolygon(const GPUBackendDrawPrecisePolygonCommand* cmd)
       .x = src.native_x, .y = src.native_y, .color = src.color, .texcoord = src.texcoord};
   }
 
-  DrawFunction(cmd, &vertices[0], &vertices[1], &vertices[2]);
+  // When upscaling, the precise positions give the scaled vertices sub-pixel precision.
+  GPU_SW_Rasterizer::DrawTriangleFunction ScaledDrawFunction = nullptr;
+  GPUBackendDrawPolygonCommand::Vertex scaled_vertices[4];
+  if (m_scale_shift > 0)
+  {
+    ScaledDrawFunction = GPU_SW_Rasterizer::GetScaledDrawTriangleFunction(
+      cmd->shading_enable, cmd->texture_enable, cmd->raw_texture_enable, cmd->transparency_enable);
+
+    const s32 scale = 1 << m_scale_shift;
+    for (u32 i = 0; i < cmd->num_vertices; i++)
+    {
+      const GPUBackendDrawPrecisePolygonCommand::Vertex& src = cmd->vertices[i];
+      scaled_vertices[i] = vertices[i];
+      scaled_vertices[i].x = GetScaledPrecisePosition(src.x, src.native_x, scale);
+      scaled_vertices[i].y = GetScaledPrecisePosition(src.y, src.native_y, scale);
+    }
+  }
+
+  DrawTriangle(DrawFunction, ScaledDrawFunction, cmd, &vertices[0], &vertices[1], &vertices[2], &scaled_vertices[0],
+               &scaled_vertices[1], &scaled_vertices[2]);
   if (cmd->num_vertices > 3)
-    DrawFunction(cmd, &vertices[2], &vertices[1], &vertices[3]);
+  {
+    DrawTriangle(DrawFunction, ScaledDrawFunction, cmd, &vertices[2], &vertices[1], &vertices[3], &scaled_vertices[2],
+                 &scaled_vertices[1], &scaled_vertices[3]);
+  }
 }
 
 void GPU_SW::DrawSprite(const GPUBackendDrawRectangleCommand* cmd)
@@ -149,23 +298,50 @@ void GPU_SW::DrawSprite(const GPUBackendDrawRectangleCommand* cmd)
 
   const GPU_SW_Rasterizer::DrawRectangleFunction DrawFunction =
     GPU_SW_Rasterizer::GetDrawRectangleFunction(cmd->texture_enable, cmd->raw_texture_enable, cmd->transparency_enable);
+  const GPU_SW_Rasterizer::DrawRectangleFunction ScaledDrawFunction =
+    (m_scale_shift > 0) ? GPU_SW_Rasterizer::GetScaledDrawRectangleFunction(cmd->texture_enable, cmd->raw_texture_enable,
+                                                                             cmd->transparency_enable) :
+                          nullptr;
+
+  if (m_binned_band_count > 0)
+  {
+    if (BinnedCommand* bcmd = QueueBinnedPrimitive(BinnedCommandType::DrawRectangle, cmd, rect))
+    {
+      bcmd->rectangle.func = DrawFunction;
+      bcmd->rectangle.scaled_func = ScaledDrawFunction;
+      bcmd->rectangle.cmd = *cmd;
+      EndBinnedPrimitive();
+      return;
+    }
+  }
 
   DrawFunction(cmd);
+  if (ScaledDrawFunction)
+  {
+    const GPUBackendDrawRectangleCommand scaled_cmd = GetScaledRectangle(cmd, m_scale_shift);
+    DrawScaled([&]() { ScaledDrawFunction(&scaled_cmd); });
+  }
 }
 
 void GPU_SW::DrawLine(const GPUBackendDrawLineCommand* cmd)
 {
   const GPU_SW_Rasterizer::DrawLineFunction DrawFunction =
     GPU_SW_Rasterizer::GetDrawLineFunction(cmd->shading_enable, cmd->transparency_enable);
+  const GPU_SW_Rasterizer::DrawLineFunction ScaledDrawFunction =
+    (m_scale_shift > 0) ? GPU_SW_Rasterizer::GetScaledDrawLineFunction(cmd->shading_enable, cmd->transparency_enable) :
+                          nullptr;
 
   for (u16 i = 0; i < cmd->num_vertices; i += 2)
-    DrawFunction(cmd, &cmd->vertices[i], &cmd->vertices[i + 1]);
+    DrawLineSegment(DrawFunction, ScaledDrawFunction, cmd, &cmd->vertices[i], &cmd->vertices[i + 1]);
 }
 
 void GPU_SW::DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd)
 {
   const GPU_SW_Rasterizer::DrawLineFunction DrawFunction =
     GPU_SW_Rasterizer::GetDrawLineFunction(cmd->shading_enable, cmd->transparency_enable);
+  const GPU_SW_Rasterizer::DrawLineFunction ScaledDrawFunction =
+    (m_scale_shift > 0) ? GPU_SW_Rasterizer::GetScaledDrawLineFunction(cmd->shading_enable, cmd->transparency_enable) :
+                          nullptr;
 
   // Need to cut out the irrelevant bits.
   // TODO: In _theory_ we could use the fixed-point parts here.
@@ -178,13 +354,177 @@ void GPU_SW::DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd)
       {.x = end.native_x, .y = end.native_y, .color = end.color},
     };
 
-    DrawFunction(cmd, &vertices[0], &vertices[1]);
+    DrawLineSegment(DrawFunction, ScaledDrawFunction, cmd, &vertices[0], &vertices[1]);
+  }
+}
+
+void GPU_SW::DrawTriangle(GPU_SW_Rasterizer::DrawTriangleFunction func,
+                          GPU_SW_Rasterizer::DrawTriangleFunction scaled_func, const GPUBackendDrawCommand* cmd,
+                          const GPUBackendDrawPolygonCommand::Vertex* v0, const GPUBackendDrawPolygonCommand::Vertex* v1,
+                          const GPUBackendDrawPolygonCommand::Vertex* v2,
+                          const GPUBackendDrawPolygonCommand::Vertex* sv0,
+                          const GPUBackendDrawPolygonCommand::Vertex* sv1,
+                          const GPUBackendDrawPolygonCommand::Vertex* sv2)
+{
+  if (m_binned_band_count > 0)
+  {
+    // Scaled vertices can be up to a pixel away from the native vertices, see GetScaledPrecisePosition().
+    const s32 pad = scaled_func ? 1 : 0;
+    const GSVector4i bounds =
+      GetPrimitiveBounds(std::min({v0->x, v1->x, v2->x}) - pad, std::min({v0->y, v1->y, v2->y}) - pad,
+                         std::max({v0->x, v1->x, v2->x}) + pad, std::max({v0->y, v1->y, v2->y}) + pad);
+
+    if (BinnedCommand* bcmd = QueueBinnedPrimitive(BinnedCommandType::DrawTriangle, cmd, bounds))
+    {
+      bcmd->triangle.func = func;
+      bcmd->triangle.scaled_func = scaled_func;
+      bcmd->triangle.cmd = *cmd;
+      bcmd->triangle.vertices[0] = *v0;
+      bcmd->triangle.vertices[1] = *v1;
+      bcmd->triangle.vertices[2] = *v2;
+      if (scaled_func)
+      {
+        bcmd->triangle.scaled_vertices[0] = *sv0;
+        bcmd->triangle.scaled_vertices[1] = *sv1;
+        bcmd->triangle.scaled_vertices[2] = *sv2;
+      }
+      EndBinnedPrimitive();
+      return;
+    }
+  }
+
+  func(cmd, v0, v1, v2);
+  if (scaled_func)
+    DrawScaled([&]() { scaled_func(cmd, sv0, sv1, sv2); });
+}
+
+void GPU_SW::DrawLineSegment(GPU_SW_Rasterizer::DrawLineFunction func, GPU_SW_Rasterizer::DrawLineFunction scaled_func,
+                             const GPUBackendDrawCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
+                             const GPUBackendDrawLineCommand::Vertex* p1)
+{
+  if (m_binned_band_count > 0)
+  {
+    const GSVector4i bounds = GetPrimitiveBounds(std::min(p0->x, p1->x), std::min(p0->y, p1->y),
+                                                 std::max(p0->x, p1->x), std::max(p0->y, p1->y));
+    if (BinnedCommand* bcmd = QueueBinnedPrimitive(BinnedCommandType::DrawLine, cmd, bounds))
+    {
+      bcmd->line.func = func;
+      bcmd->line.scaled_func = scaled_func;
+      bcmd->line.cmd = *cmd;
+      bcmd->line.vertices[0] = *p0;
+      bcmd->line.vertices[1] = *p1;
+      EndBinnedPrimitive();
+      return;
+    }
+  }
+
+  func(cmd, p0, p1);
+  if (scaled_func)
+    DrawScaled([&]() { DrawScaledLine(scaled_func, cmd, p0, p1, m_scale_shift); });
+}
+
+template<typename F>
+ALWAYS_INLINE_RELEASE void GPU_SW::DrawScaled(const F& draw)
+{
+  const GPUDrawingArea* const old_drawing_area =
+    std::exchange(GPU_SW_Rasterizer::g_thread_drawing_area, &m_scaled_drawing_area);
+  draw();
+  GPU_SW_Rasterizer::g_thread_drawing_area = old_drawing_area;
+}
+
+GPUDrawingArea GPU_SW::GetScaledDrawingArea(const GPUDrawingArea& area, u32 shift)
+{
+  // Each native pixel covers a block of scaled pixels.
+  return GPUDrawingArea{.left = area.left << shift,
+                        .top = area.top << shift,
+                        .right = ((area.right + 1) << shift) - 1,
+                        .bottom = ((area.bottom + 1) << shift) - 1};
+}
+
+GPUBackendDrawRectangleCommand GPU_SW::GetScaledRectangle(const GPUBackendDrawRectangleCommand* cmd, u32 shift)
+{
+  GPUBackendDrawRectangleCommand ret = *cmd;
+  ret.x = cmd->x * (1 << shift);
+  ret.y = cmd->y * (1 << shift);
+  ret.width = static_cast<u16>(cmd->width << shift);
+  ret.height = static_cast<u16>(cmd->height << shift);
+  return ret;
+}
+
+void GPU_SW::DrawScaledLine(GPU_SW_Rasterizer::DrawLineFunction func, const GPUBackendDrawCommand* cmd,
+                            const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1,
+                            u32 shift)
+{
+  // Lines are one pixel wide, so they're drawn once for each row or column of the scaled pixels, offset along the
+  // minor axis. The ends are extended along the major axis to cover the whole of the end pixels.
+  const s32 scale = 1 << shift;
+  const bool x_major = (std::abs(p1->x - p0->x) >= std::abs(p1->y - p0->y));
+  GPUBackendDrawLineCommand::Vertex sp0 = *p0;
+  GPUBackendDrawLineCommand::Vertex sp1 = *p1;
+  sp0.x = p0->x * scale;
+  sp0.y = p0->y * scale;
+  sp1.x = p1->x * scale;
+  sp1.y = p1->y * scale;
+
+  s32& major0 = x_major ? sp0.x : sp0.y;
+  s32& major1 = x_major ? sp1.x : sp1.y;
+  if (major1 >= major0)
+    major1 += scale - 1;
+  else
+    major0 += scale - 1;
+
+  s32& minor0 = x_major ? sp0.y : sp0.x;
+  s32& minor1 = x_major ? sp1.y : sp1.x;
+  for (s32 i = 0; i < scale; i++)
+  {
+    func(cmd, &sp0, &sp1);
+    minor0++;
+    minor1++;
   }
 }
 
 void GPU_SW::DrawingAreaChanged()
 {
   // GPU_SW_Rasterizer::g_drawing_area set by base class.
+  if (m_scale_shift > 0)
+    m_scaled_drawing_area = GetScaledDrawingArea(GPU_SW_Rasterizer::g_drawing_area, m_scale_shift);
+
+  if (m_binned_band_count == 0)
+    return;
+
+  // Bands are split from the rows of the drawing area, so if the rows change, a different thread could end up drawing
+  // over pixels which are still queued. Keeping a single split for everything in flight avoids tracking it per-area.
+  const GPUDrawingArea& area = GPU_SW_Rasterizer::g_drawing_area;
+  const bool valid = IsBinnableDrawingArea(area);
+  if (!valid || area.top != m_binned_drawing_area.top || area.bottom != m_binned_drawing_area.bottom)
+    FlushBinnedCommands();
+
+  m_binned_drawing_area = area;
+  m_binned_drawing_area_valid = valid;
+  if (valid && !m_binned_batches[0].commands.empty())
+    QueueBinnedCommand(BinnedCommandType::SetDrawingArea).drawing_area = area;
+}
+
+void GPU_SW::UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit)
+{
+  if (m_binned_band_count == 0)
+  {
+    GPU_SW_Rasterizer::UpdateCLUT(reg, clut_is_8bit);
+    return;
+  }
+
+  // Band threads use their own copy of the CLUT, so only pending draws to the palette have to be finished.
+  SyncBinnedCommands(
+    GetPaletteRect(reg, clut_is_8bit ? GPUTextureMode::Palette8Bit : GPUTextureMode::Palette4Bit), INVALID_RECT);
+  GPU_SW_Rasterizer::UpdateCLUT(reg, clut_is_8bit);
+
+  BinnedBatch& batch = m_binned_batches[0];
+  if (!batch.commands.empty())
+  {
+    const u32 index = static_cast<u32>(batch.cluts.size());
+    std::memcpy(batch.cluts.emplace_back().data(), g_gpu_clut, sizeof(g_gpu_clut));
+    QueueBinnedCommand(BinnedCommandType::SetCLUT).clut_index = index;
+  }
 }
 
 void GPU_SW::ClearCache()
@@ -199,6 +539,11 @@ void GPU_SW::FlushRender()
 {
 }
 
+void GPU_SW::OnCommandFIFOEmpty()
+{
+  FlushBinnedCommands();
+}
+
 void GPU_SW::RestoreDeviceContext()
 {
 }
@@ -222,26 +567,34 @@ GPUTexture* GPU_SW::GetDisplayTexture(u32 width, u32 height, GPUTexture::Format
 template<GPUTexture::Format display_format>
 ALWAYS_INLINE_RELEASE bool GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 line_skip)
 {
-  GPUTexture* texture = GetDisplayTexture(width, height, display_format);
+  // When upscaling, the scaled VRAM is displayed instead. Each native row maps to scale rows of the scaled VRAM.
+  const u32 shift = m_scale_shift;
+  const u32 scale_mask = (1u << shift) - 1;
+  const u16* vram = (shift > 0) ? m_scaled_vram.data() : g_vram;
+  const u32 vram_width = VRAM_WIDTH << shift;
+  const u32 out_width = width << shift;
+  const u32 out_height = height << shift;
+
+  GPUTexture* texture = GetDisplayTexture(out_width, out_height, display_format);
   if (!texture) [[unlikely]]
     return false;
 
-  u32 dst_stride = Common::AlignUpPow2(width * texture->GetPixelSize(), 4);
+  u32 dst_stride = Common::AlignUpPow2(out_width * texture->GetPixelSize(), 4);
   u8* dst_ptr = m_upload_buffer.data();
-  const bool mapped = texture->Map(reinterpret_cast<void**>(&dst_ptr), &dst_stride, 0, 0, width, height);
+  const bool mapped = texture->Map(reinterpret_cast<void**>(&dst_ptr), &dst_stride, 0, 0, out_width, out_height);
 
   // Fast path when not wrapping around.
   if ((src_x + width) <= VRAM_WIDTH && (src_y + height) <= VRAM_HEIGHT)
   {
     [[maybe_unused]] constexpr u32 pixels_per_vec = 8;
-    [[maybe_unused]] const u32 aligned_width = Common::AlignDownPow2(width, pixels_per_vec);
+    [[maybe_unused]] const u32 aligned_width = Common::AlignDownPow2(out_width, pixels_per_vec);
 
-    const u16* src_ptr = &g_vram[src_y * VRAM_WIDTH + src_x];
-    const u32 src_step = VRAM_WIDTH << line_skip;
+    const u16* src_ptr = &vram[src_x << shift];
 
-    for (u32 row = 0; row < height; row++)
+    for (u32 row = 0; row < out_height; row++)
     {
-      const u16* src_row_ptr = src_ptr;
+      const u32 y = ((src_y + ((row >> shift) << line_skip)) << shift) | (row & scale_mask);
+      const u16* src_row_ptr = &src_ptr[y * vram_width];
       u8* dst_row_ptr = dst_ptr;
       u32 x = 0;
 
@@ -253,26 +606,25 @@ ALWAYS_INLINE_RELEASE bool GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width,
       }
 #endif
 
-      for (; x < width; x++)
+      for (; x < out_width; x++)
         ConvertVRAMPixel<display_format>(dst_row_ptr, *(src_row_ptr++));
 
-      src_ptr += src_step;
       dst_ptr += dst_stride;
     }
   }
   else
   {
-    const u32 end_x = src_x + width;
-    const u32 y_step = (1 << line_skip);
-    for (u32 row = 0; row < height; row++)
+    const u32 start_x = src_x << shift;
+    const u32 end_x = start_x + out_width;
+    for (u32 row = 0; row < out_height; row++)
     {
-      const u16* src_row_ptr = &g_vram[(src_y % VRAM_HEIGHT) * VRAM_WIDTH];
+      const u32 y = (((src_y + ((row >> shift) << line_skip)) % VRAM_HEIGHT) << shift) | (row & scale_mask);
+      const u16* src_row_ptr = &vram[y * vram_width];
       u8* dst_row_ptr = dst_ptr;
 
-      for (u32 col = src_x; col < end_x; col++)
-        ConvertVRAMPixel<display_format>(dst_row_ptr, src_row_ptr[col % VRAM_WIDTH]);
+      for (u32 col = start_x; col < end_x; col++)
+        ConvertVRAMPixel<display_format>(dst_row_ptr, src_row_ptr[col % vram_width]);
 
-      src_y += y_step;
       dst_ptr += dst_stride;
     }
   }
@@ -280,7 +632,7 @@ ALWAYS_INLINE_RELEASE bool GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width,
   if (mapped)
     texture->Unmap();
   else
-    texture->Update(0, 0, width, height, m_upload_buffer.data(), dst_stride);
+    texture->Update(0, 0, out_width, out_height, m_upload_buffer.data(), dst_stride);
 
   return true;
 }
@@ -383,6 +735,8 @@ bool GPU_SW::CopyOut(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height, u3
 
 void GPU_SW::UpdateDisplay(const GPUBackendUpdateDisplayCommand* cmd)
 {
+  FlushBinnedCommands();
+
   if (!g_gpu_settings.gpu_show_vram)
   {
     if (cmd->display_disabled)
@@ -401,13 +755,17 @@ void GPU_SW::UpdateDisplay(const GPUBackendUpdateDisplayCommand* cmd)
     const u32 width = cmd->display_vram_width;
     const u32 height = cmd->display_vram_height;
 
+    // 24-bit modes are always displayed at native resolution.
+    const u32 display_shift = is_24bit ? 0 : m_scale_shift;
+
     GL_INS_FMT("Software scanout {}x{} from {},{} line_skip={}", width, height, src_x, src_y, line_skip);
 
     if (cmd->interlaced_display_enabled)
     {
       if (CopyOut(src_x, src_y, skip_x, width, height, line_skip, is_24bit))
       {
-        m_presenter.SetDisplayTexture(m_upload_texture.get(), 0, 0, width, height);
+        m_presenter.SetDisplayTexture(m_upload_texture.get(), 0, 0, width << display_shift,
+                                      height << display_shift);
         if (is_24bit && g_gpu_settings.display_24bit_chroma_smoothing)
         {
           if (m_presenter.ApplyChromaSmoothing())
@@ -423,7 +781,8 @@ void GPU_SW::UpdateDisplay(const GPUBackendUpdateDisplayCommand* cmd)
     {
       if (CopyOut(src_x, src_y, skip_x, width, height, 0, is_24bit))
       {
-        m_presenter.SetDisplayTexture(m_upload_texture.get(), 0, 0, width, height);
+        m_presenter.SetDisplayTexture(m_upload_texture.get(), 0, 0, width << display_shift,
+                                      height << display_shift);
         if (is_24bit && g_gpu_settings.display_24bit_chroma_smoothing)
           m_presenter.ApplyChromaSmoothing();
       }
@@ -432,10 +791,306 @@ void GPU_SW::UpdateDisplay(const GPUBackendUpdateDisplayCommand* cmd)
   else
   {
     if (CopyOut(0, 0, 0, VRAM_WIDTH, VRAM_HEIGHT, 0, false))
-      m_presenter.SetDisplayTexture(m_upload_texture.get(), 0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+      m_presenter.SetDisplayTexture(m_upload_texture.get(), 0, 0, VRAM_WIDTH << m_scale_shift,
+                                    VRAM_HEIGHT << m_scale_shift);
+  }
+}
+
+void GPU_SW::UpdateBandThreads()
+{
+  const u32 count = g_gpu_settings.gpu_software_renderer_threads;
+  if (count == m_binned_band_count)
+    return;
+
+  FlushBinnedCommands();
+  m_binned_task_queue.SetWorkerCount(count);
+  m_binned_band_count = count;
+  m_binned_drawing_area = GPU_SW_Rasterizer::g_drawing_area;
+  m_binned_drawing_area_valid = IsBinnableDrawingArea(m_binned_drawing_area);
+  if (count > 0)
+    INFO_LOG("Drawing software renderer primitives in {} bands.", count);
+}
+
+void GPU_SW::UpdateResolutionScale()
+{
+  const u32 shift = std::min<u32>(
+    static_cast<u32>(std::bit_width(std::max<u32>(g_gpu_settings.gpu_software_renderer_scale, 1u))) - 1, MAX_SCALE_SHIFT);
+  if (shift == m_scale_shift && !m_upload_buffer.empty())
+    return;
+
+  FlushBinnedCommands();
+  m_scale_shift = shift;
+  m_upload_buffer.resize((GPU_MAX_DISPLAY_WIDTH << shift) * (GPU_MAX_DISPLAY_HEIGHT << shift) * sizeof(u32));
+
+  if (shift == 0)
+  {
+    m_scaled_vram.deallocate();
+    GPU_SW_Rasterizer::g_scaled_vram = nullptr;
+    GPU_SW_Rasterizer::g_scaled_vram_shift = 0;
+    return;
+  }
+
+  m_scaled_vram.resize((VRAM_WIDTH << shift) * (VRAM_HEIGHT << shift));
+  GPU_SW_Rasterizer::g_scaled_vram = m_scaled_vram.data();
+  GPU_SW_Rasterizer::g_scaled_vram_shift = shift;
+  m_scaled_drawing_area = GetScaledDrawingArea(GPU_SW_Rasterizer::g_drawing_area, shift);
+  UpdateScaledVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  INFO_LOG("Upscaling software renderer by {}x.", 1u << shift);
+}
+
+void GPU_SW::UpdateScaledVRAM(u32 x, u32 y, u32 width, u32 height)
+{
+  const u32 shift = m_scale_shift;
+  const u32 scale = 1u << shift;
+  const u32 scaled_width = VRAM_WIDTH << shift;
+  for (u32 row = 0; row < height; row++)
+  {
+    const u32 src_y = (y + row) % VRAM_HEIGHT;
+    const u16* src_row_ptr = &g_vram[src_y * VRAM_WIDTH];
+    u16* dst_row_ptr = &m_scaled_vram[(src_y << shift) * scaled_width];
+    for (u32 col = 0; col < width; col++)
+    {
+      const u32 src_x = (x + col) % VRAM_WIDTH;
+      const u16 value = src_row_ptr[src_x];
+      u16* dst_ptr = &dst_row_ptr[src_x << shift];
+      for (u32 i = 0; i < scale; i++, dst_ptr += scaled_width)
+        std::fill_n(dst_ptr, scale, value);
+    }
+  }
+}
+
+void GPU_SW::CopyScaledVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask,
+                            bool check_mask)
+{
+  // Rows are copied in the same order as native VRAM. Each row is read before it's written, so overlapping copies
+  // within a row don't read pixels which have already been copied.
+  const u32 shift = m_scale_shift;
+  const u32 scale_mask = (1u << shift) - 1;
+  const u32 scaled_width = VRAM_WIDTH << shift;
+  const u32 scaled_width_mask = scaled_width - 1;
+  const u32 row_width = width << shift;
+  const u16 mask_and = check_mask ? 0x8000 : 0;
+  const u16 mask_or = set_mask ? 0x8000 : 0;
+
+  std::array<u16, (VRAM_WIDTH << MAX_SCALE_SHIFT)> row_buffer;
+  for (u32 row = 0; row < (height << shift); row++)
+  {
+    const u32 src_row = ((((src_y + (row >> shift)) % VRAM_HEIGHT) << shift) | (row & scale_mask));
+    const u32 dst_row = ((((dst_y + (row >> shift)) % VRAM_HEIGHT) << shift) | (row & scale_mask));
+    const u16* src_row_ptr = &m_scaled_vram[src_row * scaled_width];
+    u16* dst_row_ptr = &m_scaled_vram[dst_row * scaled_width];
+    for (u32 col = 0; col < row_width; col++)
+      row_buffer[col] = src_row_ptr[((src_x << shift) + col) & scaled_width_mask];
+
+    for (u32 col = 0; col < row_width; col++)
+    {
+      u16* dst_pixel_ptr = &dst_row_ptr[((dst_x << shift) + col) & scaled_width_mask];
+      *dst_pixel_ptr = ((*dst_pixel_ptr & mask_and) == 0) ? (row_buffer[col] | mask_or) : *dst_pixel_ptr;
+    }
   }
 }
 
+GPU_SW::BinnedCommand* GPU_SW::QueueBinnedPrimitive(BinnedCommandType type, const GPUBackendDrawCommand* cmd,
+                                                    GSVector4i bounds)
+{
+  if (!m_binned_drawing_area_valid)
+  {
+    FlushBinnedCommands();
+    return nullptr;
+  }
+
+  // Nothing will be drawn, so it's safe to let the rasterizer reject it on this thread.
+  const GSVector4i draw_rect = bounds.rintersect(m_clamped_drawing_area);
+  if (draw_rect.rempty())
+    return nullptr;
+
+  // Sampling from the area being drawn depends on the order that rows are drawn in, so it can't be split up.
+  const GSVector4i read_rect =
+    cmd->texture_enable ? GetTextureRect(cmd->draw_mode.texture_page, cmd->draw_mode.texture_mode) : INVALID_RECT;
+  if (read_rect.rintersects(draw_rect))
+  {
+    FlushBinnedCommands();
+    return nullptr;
+  }
+
+  // Vector stores write back up to a vector's worth of pixels past the end of a span, which can wrap around the row.
+  GSVector4i write_rect = draw_rect;
+  write_rect.right += 8;
+  if (write_rect.right > static_cast<s32>(VRAM_WIDTH))
+  {
+    write_rect.left = 0;
+    write_rect.right = static_cast<s32>(VRAM_WIDTH);
+  }
+
+  // Queued primitives in the same rows are drawn in order by the same band, but other bands could still be sampling
+  // from the area being drawn, or drawing to the area being sampled.
+  if (m_binned_write_rect.rintersects(read_rect) || m_binned_read_rect.rintersects(write_rect))
+    FlushBinnedCommands();
+
+  m_binned_read_rect = m_binned_read_rect.runion(read_rect);
+  m_binned_write_rect = m_binned_write_rect.runion(write_rect);
+
+  BinnedCommand& bcmd = QueueBinnedCommand(type);
+  bcmd.top = draw_rect.top;
+  bcmd.bottom = draw_rect.bottom - 1;
+  return &bcmd;
+}
+
+GPU_SW::BinnedCommand& GPU_SW::QueueBinnedCommand(BinnedCommandType type)
+{
+  BinnedBatch& batch = m_binned_batches[0];
+  if (batch.commands.empty())
+  {
+    // Bands can't see the previous batch's state changes, so start with the current state.
+    batch.drawing_area = GPU_SW_Rasterizer::g_drawing_area;
+    batch.scale_shift = m_scale_shift;
+    std::memcpy(batch.cluts.emplace_back().data(), g_gpu_clut, sizeof(g_gpu_clut));
+  }
+
+  BinnedCommand& bcmd = batch.commands.emplace_back();
+  bcmd.type = type;
+  return bcmd;
+}
+
+void GPU_SW::EndBinnedPrimitive()
+{
+  if (m_binned_batches[0].commands.size() >= BINNED_BATCH_SIZE)
+    KickBinnedBatch();
+}
+
+void GPU_SW::SyncBinnedCommands(const GSVector4i read_rect, const GSVector4i write_rect)
+{
+  if (m_binned_write_rect.rintersects(read_rect) || m_binned_write_rect.rintersects(write_rect) ||
+      m_binned_read_rect.rintersects(write_rect))
+  {
+    FlushBinnedCommands();
+  }
+}
+
+void GPU_SW::KickBinnedBatch()
+{
+  // Previous batch has to be finished first, otherwise primitives could be drawn out of order.
+  m_binned_task_queue.WaitForAll();
+
+  std::swap(m_binned_batches[0], m_binned_batches[1]);
+  m_binned_batches[0].commands.clear();
+  m_binned_batches[0].cluts.clear();
+
+  const BinnedBatch* batch = &m_binned_batches[1];
+  const u32 num_bands = m_binned_band_count;
+  for (u32 band = 0; band < num_bands; band++)
+    m_binned_task_queue.SubmitTask([batch, band, num_bands]() { DrawBinnedBand(*batch, band, num_bands); });
+}
+
+void GPU_SW::FlushBinnedCommands()
+{
+  if (m_binned_band_count == 0)
+    return;
+
+  if (!m_binned_batches[0].commands.empty())
+    KickBinnedBatch();
+
+  m_binned_task_queue.WaitForAll();
+  m_binned_read_rect = INVALID_RECT;
+  m_binned_write_rect = INVALID_RECT;
+}
+
+void GPU_SW::DrawBinnedBand(const BinnedBatch& batch, u32 band, u32 num_bands)
+{
+  // Bands can also be drawn on the GPU thread while it's waiting, so put its state back afterwards.
+  const GPUDrawingArea* const old_drawing_area = GPU_SW_Rasterizer::g_thread_drawing_area;
+  const u16* const old_clut = GPU_SW_Rasterizer::g_thread_clut;
+
+  // Scaled primitives are drawn to the same rows of the scaled VRAM.
+  const u32 scale_shift = batch.scale_shift;
+  GPUDrawingArea band_area;
+  GPUDrawingArea scaled_band_area;
+  const auto set_drawing_area = [&band_area, &scaled_band_area, band, num_bands,
+                                 scale_shift](const GPUDrawingArea& area) {
+    band_area = area;
+    if (area.top <= area.bottom)
+    {
+      const u32 height = area.bottom - area.top + 1;
+      band_area.top = area.top + (height * band) / num_bands;
+      band_area.bottom = area.top + (height * (band + 1)) / num_bands - 1;
+    }
+
+    scaled_band_area = GetScaledDrawingArea(band_area, scale_shift);
+  };
+
+  set_drawing_area(batch.drawing_area);
+  GPU_SW_Rasterizer::g_thread_drawing_area = &band_area;
+  GPU_SW_Rasterizer::g_thread_clut = batch.cluts.front().data();
+
+  for (const BinnedCommand& bcmd : batch.commands)
+  {
+    switch (bcmd.type)
+    {
+      case BinnedCommandType::SetDrawingArea:
+        set_drawing_area(bcmd.drawing_area);
+        continue;
+
+      case BinnedCommandType::SetCLUT:
+        GPU_SW_Rasterizer::g_thread_clut = batch.cluts[bcmd.clut_index].data();
+        continue;
+
+      default:
+        break;
+    }
+
+    if (bcmd.bottom < static_cast<s32>(band_area.top) || bcmd.top > static_cast<s32>(band_area.bottom))
+      continue;
+
+    switch (bcmd.type)
+    {
+      case BinnedCommandType::DrawTriangle:
+      {
+        bcmd.triangle.func(&bcmd.triangle.cmd, &bcmd.triangle.vertices[0], &bcmd.triangle.vertices[1],
+                           &bcmd.triangle.vertices[2]);
+        if (bcmd.triangle.scaled_func)
+        {
+          GPU_SW_Rasterizer::g_thread_drawing_area = &scaled_band_area;
+          bcmd.triangle.scaled_func(&bcmd.triangle.cmd, &bcmd.triangle.scaled_vertices[0],
+                                    &bcmd.triangle.scaled_vertices[1], &bcmd.triangle.scaled_vertices[2]);
+          GPU_SW_Rasterizer::g_thread_drawing_area = &band_area;
+        }
+      }
+      break;
+
+      case BinnedCommandType::DrawRectangle:
+      {
+        bcmd.rectangle.func(&bcmd.rectangle.cmd);
+        if (bcmd.rectangle.scaled_func)
+        {
+          const GPUBackendDrawRectangleCommand scaled_cmd = GetScaledRectangle(&bcmd.rectangle.cmd, scale_shift);
+          GPU_SW_Rasterizer::g_thread_drawing_area = &scaled_band_area;
+          bcmd.rectangle.scaled_func(&scaled_cmd);
+          GPU_SW_Rasterizer::g_thread_drawing_area = &band_area;
+        }
+      }
+      break;
+
+      case BinnedCommandType::DrawLine:
+      {
+        bcmd.line.func(&bcmd.line.cmd, &bcmd.line.vertices[0], &bcmd.line.vertices[1]);
+        if (bcmd.line.scaled_func)
+        {
+          GPU_SW_Rasterizer::g_thread_drawing_area = &scaled_band_area;
+          DrawScaledLine(bcmd.line.scaled_func, &bcmd.line.cmd, &bcmd.line.vertices[0], &bcmd.line.vertices[1],
+                         scale_shift);
+          GPU_SW_Rasterizer::g_thread_drawing_area = &band_area;
+        }
+      }
+      break;
+
+        DefaultCaseIsUnreachable();
+    }
+  }
+
+  GPU_SW_Rasterizer::g_thread_drawing_area = old_drawing_area;
+  GPU_SW_Rasterizer::g_thread_clut = old_clut;
+}
+
 std::unique_ptr<GPUBackend> GPUBackend::CreateSoftwareBackend(GPUPresenter& presenter)
 {
   return std::make_unique<GPU_SW>(presenter);
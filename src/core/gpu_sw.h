@@ -5,12 +5,17 @@
 
 #include "gpu.h"
 #include "gpu_backend.h"
+#include "gpu_sw_rasterizer.h"
 
 #include "util/gpu_device.h"
 
 #include "common/heap_array.h"
+#include "common/task_queue.h"
 
+#include <array>
+#include <limits>
 #include <memory>
+#include <vector>
 
 // TODO: Move to cpp
 // TODO: Rename to GPUSWBackend, preserved to avoid conflicts.
@@ -21,9 +26,11 @@ public:
   ~GPU_SW() override;
 
   bool Initialize(bool upload_vram, Error* error) override;
+  bool UpdateSettings(const GPUSettings& old_settings, Error* error) override;
 
   void RestoreDeviceContext() override;
   void FlushRender() override;
+  void OnCommandFIFOEmpty() override;
 
   u32 GetResolutionScale() const override;
 
@@ -39,6 +46,7 @@ public:
   void DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd) override;
   void DrawSprite(const GPUBackendDrawRectangleCommand* cmd) override;
   void DrawingAreaChanged() override;
+  void UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit) override;
   void ClearCache() override;
   void OnBufferSwapped() override;
 
@@ -54,6 +62,117 @@ public:
 private:
   static constexpr GPUTexture::Format FORMAT_FOR_24BIT = GPUTexture::Format::RGBA8; // RGBA8 always supported.
 
+  static constexpr GSVector4i INVALID_RECT =
+    GSVector4i::cxpr(std::numeric_limits<s32>::max(), std::numeric_limits<s32>::max(), std::numeric_limits<s32>::min(),
+                     std::numeric_limits<s32>::min());
+
+  // Number of commands queued before they're handed to the band threads.
+  static constexpr u32 BINNED_BATCH_SIZE = 256;
+
+  // Largest internal resolution is 4x.
+  static constexpr u32 MAX_SCALE_SHIFT = 2;
+
+  enum class BinnedCommandType : u8
+  {
+    SetDrawingArea,
+    SetCLUT,
+    DrawTriangle,
+    DrawRectangle,
+    DrawLine,
+  };
+
+  struct BinnedCommand
+  {
+    BinnedCommandType type;
+
+    // Rows which can be touched by the primitive, so bands can skip it without any setup.
+    s32 top;
+    s32 bottom;
+
+    union
+    {
+      GPUDrawingArea drawing_area;
+      u32 clut_index;
+
+      struct
+      {
+        GPU_SW_Rasterizer::DrawTriangleFunction func;
+        GPU_SW_Rasterizer::DrawTriangleFunction scaled_func;
+        GPUBackendDrawCommand cmd;
+        GPUBackendDrawPolygonCommand::Vertex vertices[3];
+        GPUBackendDrawPolygonCommand::Vertex scaled_vertices[3];
+      } triangle;
+
+      struct
+      {
+        GPU_SW_Rasterizer::DrawRectangleFunction func;
+        GPU_SW_Rasterizer::DrawRectangleFunction scaled_func;
+        GPUBackendDrawRectangleCommand cmd;
+      } rectangle;
+
+      struct
+      {
+        GPU_SW_Rasterizer::DrawLineFunction func;
+        GPU_SW_Rasterizer::DrawLineFunction scaled_func;
+        GPUBackendDrawCommand cmd;
+        GPUBackendDrawLineCommand::Vertex vertices[2];
+      } line;
+    };
+  };
+
+  struct BinnedBatch
+  {
+    std::vector<BinnedCommand> commands;
+
+    // First CLUT is the one active at the start of the batch.
+    std::vector<std::array<u16, GPU_CLUT_SIZE>> cluts;
+    GPUDrawingArea drawing_area;
+
+    // Primitives with a scaled function are also drawn to the scaled VRAM.
+    u32 scale_shift;
+  };
+
+  void UpdateBandThreads();
+  void UpdateResolutionScale();
+
+  /// Copies an area of native VRAM to the scaled VRAM, duplicating each pixel.
+  void UpdateScaledVRAM(u32 x, u32 y, u32 width, u32 height);
+  void CopyScaledVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask,
+                      bool check_mask);
+
+  /// Draws with the drawing area in scaled coordinates.
+  template<typename F>
+  void DrawScaled(const F& draw);
+
+  /// Returns the command to fill in if the primitive can be drawn by the band threads, otherwise it must be drawn
+  /// immediately. EndBinnedPrimitive() must be called once the command is filled in.
+  BinnedCommand* QueueBinnedPrimitive(BinnedCommandType type, const GPUBackendDrawCommand* cmd, GSVector4i bounds);
+  BinnedCommand& QueueBinnedCommand(BinnedCommandType type);
+  void EndBinnedPrimitive();
+
+  /// Waits for the band threads if they could be accessing the area being written, or writing the area being read.
+  void SyncBinnedCommands(const GSVector4i read_rect, const GSVector4i write_rect);
+  void KickBinnedBatch();
+  void FlushBinnedCommands();
+
+  static void DrawBinnedBand(const BinnedBatch& batch, u32 band, u32 num_bands);
+
+  static GPUDrawingArea GetScaledDrawingArea(const GPUDrawingArea& area, u32 shift);
+  static GPUBackendDrawRectangleCommand GetScaledRectangle(const GPUBackendDrawRectangleCommand* cmd, u32 shift);
+  static void DrawScaledLine(GPU_SW_Rasterizer::DrawLineFunction func, const GPUBackendDrawCommand* cmd,
+                             const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1,
+                             u32 shift);
+
+  /// Scaled vertices and function are only used when upscaling.
+  void DrawTriangle(GPU_SW_Rasterizer::DrawTriangleFunction func, GPU_SW_Rasterizer::DrawTriangleFunction scaled_func,
+                    const GPUBackendDrawCommand* cmd, const GPUBackendDrawPolygonCommand::Vertex* v0,
+                    const GPUBackendDrawPolygonCommand::Vertex* v1, const GPUBackendDrawPolygonCommand::Vertex* v2,
+                    const GPUBackendDrawPolygonCommand::Vertex* sv0, const GPUBackendDrawPolygonCommand::Vertex* sv1,
+                    const GPUBackendDrawPolygonCommand::Vertex* sv2);
+  void DrawLineSegment(GPU_SW_Rasterizer::DrawLineFunction func, GPU_SW_Rasterizer::DrawLineFunction scaled_func,
+                       const GPUBackendDrawCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
+                       const GPUBackendDrawLineCommand::Vertex* p1);
+
   template<GPUTexture::Format display_format>
   bool CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 line_skip);
 
@@ -63,7 +182,23 @@ private:
 
   GPUTexture* GetDisplayTexture(u32 width, u32 height, GPUTexture::Format format);
 
-  FixedHeapArray<u8, GPU_MAX_DISPLAY_WIDTH * GPU_MAX_DISPLAY_HEIGHT * sizeof(u32)> m_upload_buffer;
+  DynamicHeapArray<u8> m_upload_buffer;
   GPUTexture::Format m_16bit_display_format = GPUTexture::Format::Unknown;
   std::unique_ptr<GPUTexture> m_upload_texture;
+
+  // Internal upscaling, primitives are drawn to both native VRAM and a scaled copy, which is what gets displayed.
+  // Native VRAM is still used for readbacks and texturing, and transfers are copied over to the scaled VRAM.
+  DynamicHeapArray<u16> m_scaled_vram;
+  GPUDrawingArea m_scaled_drawing_area = {};
+  u32 m_scale_shift = 0;
+
+  // Binned rendering, primitives are queued and drawn in horizontal bands of the drawing area on multiple threads.
+  // The first batch is being queued, the second is being drawn.
+  std::array<BinnedBatch, 2> m_binned_batches;
+  GSVector4i m_binned_read_rect = INVALID_RECT;
+  GSVector4i m_binned_write_rect = INVALID_RECT;
+  GPUDrawingArea m_binned_drawing_area = {};
+  u32 m_binned_band_count = 0;
+  bool m_binned_drawing_area_valid = false;
+  TaskQueue m_binned_task_queue;
 };
@@ -36,6 +36,10 @@ FillVRAMFunction FillVRAM = nullptr;
 WriteVRAMFunction WriteVRAM = nullptr;
 CopyVRAMFunction CopyVRAM = nullptr;
 GPUDrawingArea g_drawing_area = {};
+u16* g_scaled_vram = nullptr;
+u32 g_scaled_vram_shift = 0;
+thread_local const GPUDrawingArea* g_thread_drawing_area = &g_drawing_area;
+thread_local const u16* g_thread_clut = g_gpu_clut;
 } // namespace GPU_SW_Rasterizer
 
 void GPU_SW_Rasterizer::UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit)
@@ -81,6 +85,17 @@ namespace {
 } // namespace GPU_SW_Rasterizer::SIMD
 #endif
 
+// Scaled implementation, only built for the base ISA. Not in an anonymous namespace, since it's called directly.
+namespace GPU_SW_Rasterizer::Scaled {
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+#define USE_VECTOR 1
+#endif
+#define USE_SCALED_TARGET 1
+#include "gpu_sw_rasterizer.inl"
+#undef USE_SCALED_TARGET
+#undef USE_VECTOR
+} // namespace GPU_SW_Rasterizer::Scaled
+
 // Declare alternative implementations.
 void GPU_SW_Rasterizer::SelectImplementation()
 {
@@ -105,9 +120,8 @@ void GPU_SW_Rasterizer::SelectImplementation()
 #if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
   const char* use_isa = std::getenv("SW_USE_ISA");
 
-  // AVX2/256-bit path still has issues, and I need to make sure that it's not ODR'ing any shared
-  // symbols on top of the base symbols.
-#if defined(CPU_ARCH_SSE) && defined(_MSC_VER) && 0
+  // AVX2 is built in its own translation unit, with its own copy of GSVector, see gpu_sw_rasterizer_avx2.cpp.
+#ifdef GPU_SW_RASTERIZER_ENABLE_AVX2
   if (cpuinfo_has_x86_avx2() && (!use_isa || StringUtil::Strcasecmp(use_isa, "AVX2") == 0))
   {
     SELECT_IMPLEMENTATION(AVX2);
@@ -22,6 +22,16 @@ extern const DitherLUT g_dither_lut;
 // TODO: Pack in struct
 extern GPUDrawingArea g_drawing_area;
 
+// Drawing area and CLUT used when rasterizing on the calling thread. These point to g_drawing_area/g_gpu_clut, except
+// on the binned renderer's worker threads, where the drawing area is limited to the worker's band.
+extern thread_local const GPUDrawingArea* g_thread_drawing_area;
+extern thread_local const u16* g_thread_clut;
+
+// Scaled copy of VRAM which primitives are also drawn to when upscaling, (VRAM_WIDTH << shift) by (VRAM_HEIGHT << shift).
+// Textures and CLUTs are always read from g_vram, which stays authoritative.
+extern u16* g_scaled_vram;
+extern u32 g_scaled_vram_shift;
+
 extern void UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit);
 
 using DrawRectangleFunction = void (*)(const GPUBackendDrawRectangleCommand* cmd);
@@ -70,15 +80,49 @@ ALWAYS_INLINE DrawTriangleFunction GetDrawTriangleFunction(bool shading_enable,
     *DrawTriangleFunctions)[u8(shading_enable)][u8(texture_enable)][u8(raw_texture_enable)][u8(transparency_enable)];
 }
 
+// Rasterizer for g_scaled_vram. Positions and the drawing area are in scaled coordinates, texture coordinates are not.
+namespace Scaled {
+extern const DrawRectangleFunctionTable DrawRectangleFunctions;
+extern const DrawTriangleFunctionTable DrawTriangleFunctions;
+extern const DrawLineFunctionTable DrawLineFunctions;
+} // namespace Scaled
+
+ALWAYS_INLINE DrawLineFunction GetScaledDrawLineFunction(bool shading_enable, bool transparency_enable)
+{
+  return Scaled::DrawLineFunctions[u8(shading_enable)][u8(transparency_enable)];
+}
+
+ALWAYS_INLINE DrawRectangleFunction GetScaledDrawRectangleFunction(bool texture_enable, bool raw_texture_enable,
+                                                                   bool transparency_enable)
+{
+  return Scaled::DrawRectangleFunctions[u8(texture_enable)][u8(raw_texture_enable)][u8(transparency_enable)];
+}
+
+ALWAYS_INLINE DrawTriangleFunction GetScaledDrawTriangleFunction(bool shading_enable, bool texture_enable,
+                                                                 bool raw_texture_enable, bool transparency_enable)
+{
+  return Scaled::DrawTriangleFunctions[u8(shading_enable)][u8(texture_enable)][u8(raw_texture_enable)]
+                                      [u8(transparency_enable)];
+}
+
 #define DECLARE_ALTERNATIVE_RASTERIZER(isa)                                                                            \
   namespace isa {                                                                                                      \
   extern const DrawRectangleFunctionTable DrawRectangleFunctions;                                                      \
   extern const DrawTriangleFunctionTable DrawTriangleFunctions;                                                        \
   extern const DrawLineFunctionTable DrawLineFunctions;                                                                \
+  void FillVRAMImpl(u32 x, u32 y, u32 width, u32 height, u32 color, bool interlaced, u8 active_line_lsb);              \
+  void WriteVRAMImpl(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask);           \
+  void CopyVRAMImpl(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask,                  \
+                    bool check_mask);                                                                                  \
   }
 
+// AVX2 is only needed as an alternative if the whole program isn't already being compiled for it.
+#if defined(CPU_ARCH_SSE) && !defined(CPU_ARCH_AVX2)
+#define GPU_SW_RASTERIZER_ENABLE_AVX2 1
+#endif
+
 // Have to define the symbols globally, because clang won't include them otherwise.
-#if defined(CPU_ARCH_SSE) && 0
+#if defined(GPU_SW_RASTERIZER_ENABLE_AVX2)
 #define ALTERNATIVE_RASTERIZER_LIST() DECLARE_ALTERNATIVE_RASTERIZER(AVX2)
 #else
 #define ALTERNATIVE_RASTERIZER_LIST()
@@ -54,17 +54,65 @@ static u32 s_bad_counter = 0;
 #endif
 #endif
 
+// Primitives are drawn to the target, which is g_scaled_vram for the scaled rasterizer. Positions, the drawing area
+// and interlaced fields are in target coordinates, but textures are always sampled from g_vram.
+#ifdef USE_SCALED_TARGET
+ALWAYS_INLINE_RELEASE static u16* GetTargetVRAM()
+{
+  return g_scaled_vram;
+}
+ALWAYS_INLINE_RELEASE static u32 GetTargetShift()
+{
+  return g_scaled_vram_shift;
+}
+ALWAYS_INLINE_RELEASE static s32 TruncateTargetPosition(s32 x)
+{
+  const u32 shift = 32 - 11 - GetTargetShift();
+  return static_cast<s32>(static_cast<u32>(x) << shift) >> shift;
+}
+#else
+ALWAYS_INLINE_RELEASE static u16* GetTargetVRAM()
+{
+  return g_vram;
+}
+ALWAYS_INLINE_RELEASE static constexpr u32 GetTargetShift()
+{
+  return 0;
+}
+ALWAYS_INLINE_RELEASE static constexpr s32 TruncateTargetPosition(s32 x)
+{
+  return TruncateGPUVertexPosition(x);
+}
+#endif
+
+[[maybe_unused]] ALWAYS_INLINE_RELEASE static u32 GetTargetWidth()
+{
+  return VRAM_WIDTH << GetTargetShift();
+}
+[[maybe_unused]] ALWAYS_INLINE_RELEASE static u32 GetTargetWidthMask()
+{
+  return GetTargetWidth() - 1;
+}
+[[maybe_unused]] ALWAYS_INLINE_RELEASE static u32 GetTargetHeightMask()
+{
+  return (VRAM_HEIGHT << GetTargetShift()) - 1;
+}
+[[maybe_unused]] ALWAYS_INLINE_RELEASE static bool GetTargetLineLSB(s32 y)
+{
+  return ConvertToBoolUnchecked((static_cast<u32>(y) >> GetTargetShift()) & 1u);
+}
+
 [[maybe_unused]] ALWAYS_INLINE_RELEASE static u16 GetPixel(const u32 x, const u32 y)
 {
   return g_vram[VRAM_WIDTH * y + x];
 }
-[[maybe_unused]] ALWAYS_INLINE_RELEASE static u16* GetPixelPtr(const u32 x, const u32 y)
+[[maybe_unused]] ALWAYS_INLINE_RELEASE static u16 GetTargetPixel(const u32 x, const u32 y)
 {
-  return &g_vram[VRAM_WIDTH * y + x];
+  return GetTargetVRAM()[GetTargetWidth() * y + x];
 }
-[[maybe_unused]] ALWAYS_INLINE_RELEASE static void SetPixel(const u32 x, const u32 y, const u16 value)
+[[maybe_unused]] ALWAYS_INLINE_RELEASE static void SetTargetPixel(const u32 x, const u32 y, const u16 value)
 {
-  g_vram[VRAM_WIDTH * y + x] = value;
+  GetTargetVRAM()[GetTargetWidth() * y + x] = value;
 }
 
 [[maybe_unused]] ALWAYS_INLINE_RELEASE static constexpr std::tuple<u8, u8> UnpackTexcoord(u16 texcoord)
@@ -98,7 +146,7 @@ template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
           GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
                    (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
         const size_t palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
-        texture_color = g_gpu_clut[palette_index];
+        texture_color = g_thread_clut[palette_index];
       }
       break;
 
@@ -108,7 +156,7 @@ template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
           GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
                    (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
         const size_t palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
-        texture_color = g_gpu_clut[palette_index];
+        texture_color = g_thread_clut[palette_index];
       }
       break;
 
@@ -153,7 +201,7 @@ template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
             (ZeroExtend16(g_dither_lut[dither_y][dither_x][color_b]) << 10) | (transparency_enable ? 0x8000u : 0);
   }
 
-  const u16 bg_color = GetPixel(static_cast<u32>(x), static_cast<u32>(y));
+  const u16 bg_color = GetTargetPixel(static_cast<u32>(x), static_cast<u32>(y));
   if constexpr (transparency_enable)
   {
     if (color & 0x8000u || !texture_enable)
@@ -219,8 +267,8 @@ template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
   if ((bg_color & mask_and) != 0)
     return;
 
-  DebugAssert(static_cast<u32>(x) < VRAM_WIDTH && static_cast<u32>(y) < VRAM_HEIGHT);
-  SetPixel(static_cast<u32>(x), static_cast<u32>(y), color | cmd->GetMaskOR());
+  DebugAssert(static_cast<u32>(x) <= GetTargetWidthMask() && static_cast<u32>(y) <= GetTargetHeightMask());
+  SetTargetPixel(static_cast<u32>(x), static_cast<u32>(y), color | cmd->GetMaskOR());
 }
 
 #ifndef USE_VECTOR
@@ -232,27 +280,28 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   const s32 origin_y = cmd->y;
   const auto [r, g, b] = UnpackColorRGB24(cmd->color);
   const auto [origin_texcoord_x, origin_texcoord_y] = UnpackTexcoord(cmd->texcoord);
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
 
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y < static_cast<s32>(g_drawing_area.top) || y > static_cast<s32>(g_drawing_area.bottom) ||
+    if (y < static_cast<s32>(drawing_area.top) || y > static_cast<s32>(drawing_area.bottom) ||
         (cmd->interlaced_rendering &&
-         cmd->active_line_lsb == ConvertToBoolUnchecked(Truncate8(static_cast<u32>(y)) & 1u)))
+         cmd->active_line_lsb == GetTargetLineLSB(y)))
     {
       continue;
     }
 
-    const u32 draw_y = static_cast<u32>(y) & VRAM_HEIGHT_MASK;
-    const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + offset_y);
+    const u32 draw_y = static_cast<u32>(y) & GetTargetHeightMask();
+    const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + (offset_y >> GetTargetShift()));
 
     for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
     {
       const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(g_drawing_area.left) || x > static_cast<s32>(g_drawing_area.right))
+      if (x < static_cast<s32>(drawing_area.left) || x > static_cast<s32>(drawing_area.right))
         continue;
 
-      const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
+      const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + (offset_x >> GetTargetShift()));
 
       ShadePixel<texture_enable, raw_texture_enable, transparency_enable>(cmd, static_cast<u32>(x), draw_y, r, g, b,
                                                                           texcoord_x, texcoord_y);
@@ -278,55 +327,44 @@ static constexpr u32 PIXELS_PER_VEC = 4;
 
 #ifdef GSVECTOR_HAS_256
 
+// Gathers the 32-bit words containing each 16-bit value, so nothing past the end of the array is read, then shifts the
+// value down from whichever half it was in.
+ALWAYS_INLINE_RELEASE static GSVector8i Gather16Vector(const u16* base, GSVector8i offsets)
+{
+  const GSVector8i words = GSVector8i::gather32<4>(base, offsets.srl32<1>());
+  return words.srlv32((offsets & GSVector8i::cxpr(1)).sll32<4>()) & GSVector8i::cxpr(0xFFFF);
+}
+
 ALWAYS_INLINE_RELEASE static GSVector8i GatherVector(GSVector8i coord_x, GSVector8i coord_y)
 {
-  const GSVector8i offsets = coord_y.sll32<10>().add32(coord_x); // y * 1024 + x
-  GSVector8i pixels = GSVector8i::zext32(g_vram[static_cast<u32>(offsets.extract32<0>())]);
-  pixels = pixels.insert16<2>(g_vram[static_cast<u32>(offsets.extract32<1>())]);
-  pixels = pixels.insert16<4>(g_vram[static_cast<u32>(offsets.extract32<2>())]);
-  pixels = pixels.insert16<6>(g_vram[static_cast<u32>(offsets.extract32<3>())]);
-  pixels = pixels.insert16<8>(g_vram[static_cast<u32>(offsets.extract32<4>())]);
-  pixels = pixels.insert16<10>(g_vram[static_cast<u32>(offsets.extract32<5>())]);
-  pixels = pixels.insert16<12>(g_vram[static_cast<u32>(offsets.extract32<6>())]);
-  pixels = pixels.insert16<14>(g_vram[static_cast<u32>(offsets.extract32<7>())]);
-  return pixels;
+  return Gather16Vector(g_vram, coord_y.sll32<10>().add32(coord_x)); // y * 1024 + x
 }
 
-template<u32 mask>
-ALWAYS_INLINE_RELEASE static GSVector8i GatherCLUTVector(GSVector8i indices, GSVector8i shifts)
+ALWAYS_INLINE_RELEASE static GSVector8i LookupCLUTVector(GSVector8i indices)
 {
-  const GSVector8i offsets = indices.srlv32(shifts) & GSVector8i::cxpr(mask);
-  GSVector8i pixels = GSVector8i::zext32(g_gpu_clut[static_cast<u32>(offsets.extract32<0>())]);
-  pixels = pixels.insert16<2>(g_gpu_clut[static_cast<u32>(offsets.extract32<1>())]);
-  pixels = pixels.insert16<4>(g_gpu_clut[static_cast<u32>(offsets.extract32<2>())]);
-  pixels = pixels.insert16<6>(g_gpu_clut[static_cast<u32>(offsets.extract32<3>())]);
-  pixels = pixels.insert16<8>(g_gpu_clut[static_cast<u32>(offsets.extract32<4>())]);
-  pixels = pixels.insert16<10>(g_gpu_clut[static_cast<u32>(offsets.extract32<5>())]);
-  pixels = pixels.insert16<12>(g_gpu_clut[static_cast<u32>(offsets.extract32<6>())]);
-  pixels = pixels.insert16<14>(g_gpu_clut[static_cast<u32>(offsets.extract32<7>())]);
-  return pixels;
+  return Gather16Vector(g_thread_clut, indices);
 }
 
 ALWAYS_INLINE_RELEASE static GSVector8i LoadVector(u32 x, u32 y)
 {
   // TODO: Split into high/low
-  if (x <= (VRAM_WIDTH - 8))
+  if (x <= (GetTargetWidth() - 8))
   {
-    return GSVector8i::u16to32(GSVector4i::load<false>(&g_vram[y * VRAM_WIDTH + x]));
+    return GSVector8i::u16to32(GSVector4i::load<false>(&GetTargetVRAM()[y * GetTargetWidth() + x]));
   }
   else
   {
     // TODO: Avoid loads for masked pixels if a contiguous region is masked
-    const u16* line = &g_vram[y * VRAM_WIDTH];
+    const u16* line = &GetTargetVRAM()[y * GetTargetWidth()];
     GSVector8i pixels = GSVector8i::zero();
-    pixels = pixels.insert16<0>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<2>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<4>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<6>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<8>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<10>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<12>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<14>(line[(x++) & VRAM_WIDTH_MASK]);
+    pixels = pixels.insert16<0>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<2>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<4>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<6>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<8>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<10>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<12>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<14>(line[(x++) & GetTargetWidthMask()]);
     return pixels;
   }
 }
@@ -335,22 +373,22 @@ ALWAYS_INLINE_RELEASE static void StoreVector(u32 x, u32 y, GSVector8i color)
 {
   // TODO: Split into high/low
   const GSVector4i packed = color.low128().pu32(color.high128());
-  if (x <= (VRAM_WIDTH - 8))
+  if (x <= (GetTargetWidth() - 8))
   {
-    GSVector4i::store<false>(&g_vram[y * VRAM_WIDTH + x], packed);
+    GSVector4i::store<false>(&GetTargetVRAM()[y * GetTargetWidth() + x], packed);
   }
   else
   {
     // TODO: Avoid stores for masked pixels if a contiguous region is masked
-    u16* line = &g_vram[y * VRAM_WIDTH];
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<0>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<1>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<2>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<3>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<4>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<5>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<6>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed.extract16<7>());
+    u16* line = &GetTargetVRAM()[y * GetTargetWidth()];
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<0>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<1>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<2>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<3>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<4>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<5>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<6>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed.extract16<7>());
   }
 }
 
@@ -369,46 +407,30 @@ ALWAYS_INLINE_RELEASE static GSVector4i GatherVector(GSVector4i coord_x, GSVecto
   return pixels;
 }
 
-template<u32 mask>
-ALWAYS_INLINE_RELEASE static GSVector4i GatherCLUTVector(GSVector4i indices, GSVector4i shifts)
+ALWAYS_INLINE_RELEASE static GSVector4i LookupCLUTVector(GSVector4i indices)
 {
-#ifdef GSVECTOR_HAS_SRLV
   // On everywhere except RISC-V, we can do the shl 1 (* 2) as part of the load instruction.
-  const GSVector4i offsets = indices.srlv32(shifts) & GSVector4i::cxpr(mask);
-  GSVector4i pixels = GSVector4i::zext32(g_gpu_clut[static_cast<u32>(offsets.extract32<0>())]);
-  pixels = pixels.insert16<2>(g_gpu_clut[static_cast<u32>(offsets.extract32<1>())]);
-  pixels = pixels.insert16<4>(g_gpu_clut[static_cast<u32>(offsets.extract32<2>())]);
-  pixels = pixels.insert16<6>(g_gpu_clut[static_cast<u32>(offsets.extract32<3>())]);
+  const u16* const clut = g_thread_clut;
+  GSVector4i pixels = GSVector4i::zext32(clut[static_cast<u32>(indices.extract32<0>())]);
+  pixels = pixels.insert16<2>(clut[static_cast<u32>(indices.extract32<1>())]);
+  pixels = pixels.insert16<4>(clut[static_cast<u32>(indices.extract32<2>())]);
+  pixels = pixels.insert16<6>(clut[static_cast<u32>(indices.extract32<3>())]);
   return pixels;
-#else
-  // Without variable shifts, it's probably quicker to do it without vectors.
-  // Because otherwise we have to do 4 separate vector shifts, as well as broadcasting the shifts...
-  // Clang seems to turn this into a bunch of extracts, and skips memory. Nice.
-  alignas(VECTOR_ALIGNMENT) s32 indices_array[4], shifts_array[4];
-  GSVector4i::store<true>(indices_array, indices);
-  GSVector4i::store<true>(shifts_array, shifts);
-
-  GSVector4i pixels = GSVector4i::zext32(g_gpu_clut[((indices_array[0] >> shifts_array[0]) & mask)]);
-  pixels = pixels.insert16<2>(g_gpu_clut[((indices_array[1] >> shifts_array[1]) & mask)]);
-  pixels = pixels.insert16<4>(g_gpu_clut[((indices_array[2] >> shifts_array[2]) & mask)]);
-  pixels = pixels.insert16<6>(g_gpu_clut[((indices_array[3] >> shifts_array[3]) & mask)]);
-  return pixels;
-#endif
 }
 
 ALWAYS_INLINE_RELEASE static GSVector4i LoadVector(u32 x, u32 y)
 {
-  if (x <= (VRAM_WIDTH - 4))
+  if (x <= (GetTargetWidth() - 4))
   {
-    return GSVector4i::loadl<false>(&g_vram[y * VRAM_WIDTH + x]).u16to32();
+    return GSVector4i::loadl<false>(&GetTargetVRAM()[y * GetTargetWidth() + x]).u16to32();
   }
   else
   {
-    const u16* line = &g_vram[y * VRAM_WIDTH];
-    GSVector4i pixels = GSVector4i(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<2>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<4>(line[(x++) & VRAM_WIDTH_MASK]);
-    pixels = pixels.insert16<6>(line[x & VRAM_WIDTH_MASK]);
+    const u16* line = &GetTargetVRAM()[y * GetTargetWidth()];
+    GSVector4i pixels = GSVector4i(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<2>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<4>(line[(x++) & GetTargetWidthMask()]);
+    pixels = pixels.insert16<6>(line[x & GetTargetWidthMask()]);
     return pixels;
   }
 }
@@ -416,22 +438,51 @@ ALWAYS_INLINE_RELEASE static GSVector4i LoadVector(u32 x, u32 y)
 ALWAYS_INLINE_RELEASE static void StoreVector(u32 x, u32 y, GSVector4i color)
 {
   const GSVector4i packed_color = color.pu32();
-  if (x <= (VRAM_WIDTH - 4))
+  if (x <= (GetTargetWidth() - 4))
   {
-    GSVector4i::storel<false>(&g_vram[y * VRAM_WIDTH + x], packed_color);
+    GSVector4i::storel<false>(&GetTargetVRAM()[y * GetTargetWidth() + x], packed_color);
   }
   else
   {
-    u16* line = &g_vram[y * VRAM_WIDTH];
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed_color.extract16<0>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed_color.extract16<1>());
-    line[(x++) & VRAM_WIDTH_MASK] = Truncate16(packed_color.extract16<2>());
-    line[x & VRAM_WIDTH_MASK] = Truncate16(packed_color.extract16<3>());
+    u16* line = &GetTargetVRAM()[y * GetTargetWidth()];
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed_color.extract16<0>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed_color.extract16<1>());
+    line[(x++) & GetTargetWidthMask()] = Truncate16(packed_color.extract16<2>());
+    line[x & GetTargetWidthMask()] = Truncate16(packed_color.extract16<3>());
   }
 }
 
 #endif
 
+// Extracts the palette index for each pixel from the texel containing it, for 4-bit (0x0F) or 8-bit (0xFF) textures.
+template<u32 mask>
+ALWAYS_INLINE_RELEASE static GSVectorNi GetCLUTIndices(GSVectorNi texels, GSVectorNi shifts)
+{
+#ifdef GSVECTOR_HAS_SRLV
+  return texels.srlv32(shifts) & GSVectorNi::cxpr(mask);
+#else
+  // Shifts are multiples of the index size, so it only takes one or two steps to do it without variable shifts.
+  texels = texels.blend8(texels.srl32<8>(), (shifts & GSVectorNi::cxpr(8)).eq32(GSVectorNi::cxpr(8)));
+  if constexpr (mask == 0x0F)
+    texels = texels.blend8(texels.srl32<4>(), (shifts & GSVectorNi::cxpr(4)).eq32(GSVectorNi::cxpr(4)));
+
+  return texels & GSVectorNi::cxpr(mask);
+#endif
+}
+
+#ifdef GSVECTOR_HAS_FAST_INT_SHUFFLE8
+
+// Looks up 4-bit palette indices with byte shuffles, using the low and high bytes of the 16 colours split into
+// separate registers. The other bytes of each pixel have the top bit set, so they select zero.
+ALWAYS_INLINE_RELEASE static GSVectorNi LookupCLUT4Vector(GSVectorNi clut_lo, GSVectorNi clut_hi, GSVectorNi indices)
+{
+  const GSVectorNi lo = clut_lo.shuffle8(indices | GSVectorNi::cxpr(static_cast<s32>(0x80808000u)));
+  const GSVectorNi hi = clut_hi.shuffle8(indices.sll32<8>() | GSVectorNi::cxpr(static_cast<s32>(0x80800080u)));
+  return lo | hi;
+}
+
+#endif
+
 ALWAYS_INLINE_RELEASE static void RGB5A1ToRG_BA(GSVectorNi rgb5a1, GSVectorNi& rg, GSVectorNi& ba)
 {
   rg = rgb5a1 & GSVectorNi::cxpr(0x1F);                     // R | R | R | R
@@ -484,10 +535,15 @@ struct PixelVectors
   NO_UNIQUE_ADDRESS typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> texture_base_x;
   NO_UNIQUE_ADDRESS typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> texture_base_y;
 
+#ifdef GSVECTOR_HAS_FAST_INT_SHUFFLE8
+  NO_UNIQUE_ADDRESS typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> clut4_lo;
+  NO_UNIQUE_ADDRESS typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> clut4_hi;
+#endif
+
   PixelVectors(const GPUBackendDrawCommand* cmd)
   {
-    clip_left = GSVectorNi(g_drawing_area.left);
-    clip_right = GSVectorNi(g_drawing_area.right);
+    clip_left = GSVectorNi(g_thread_drawing_area->left);
+    clip_right = GSVectorNi(g_thread_drawing_area->right);
 
     mask_and = GSVectorNi(cmd->GetMaskAND());
     mask_or = GSVectorNi(cmd->GetMaskOR());
@@ -500,6 +556,18 @@ struct PixelVectors
       texture_window_or_y = GSVectorNi(cmd->window.or_y);
       texture_base_x = GSVectorNi(cmd->draw_mode.GetTexturePageBaseX());
       texture_base_y = GSVectorNi(cmd->draw_mode.GetTexturePageBaseY());
+
+#ifdef GSVECTOR_HAS_FAST_INT_SHUFFLE8
+      if (cmd->draw_mode.texture_mode == GPUTextureMode::Palette4Bit)
+      {
+        // Deinterleave the low and high bytes of the 16 colours.
+        static constexpr GSVector4i split = GSVector4i::cxpr8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+        const GSVector4i colors_0_7 = GSVector4i::load<false>(&g_thread_clut[0]).shuffle8(split);
+        const GSVector4i colors_8_15 = GSVector4i::load<false>(&g_thread_clut[8]).shuffle8(split);
+        clut4_lo = GSVectorNi::broadcast128(colors_0_7.upl64(colors_8_15));
+        clut4_hi = GSVectorNi::broadcast128(colors_0_7.uph64(colors_8_15));
+      }
+#endif
     }
   }
 };
@@ -535,8 +603,13 @@ ALWAYS_INLINE_RELEASE static void ShadePixel(const PixelVectors<texture_enable>&
         load_texcoord_x = load_texcoord_x & coord_mask_x;
 
         const GSVectorNi palette_shift = (texcoord_x & GSVectorNi::cxpr(3)).sll32<2>();
-        const GSVectorNi palette_indices = GatherVector(load_texcoord_x, texcoord_y);
-        texture_color = GatherCLUTVector<0x0F>(palette_indices, palette_shift);
+        const GSVectorNi palette_indices =
+          GetCLUTIndices<0x0F>(GatherVector(load_texcoord_x, texcoord_y), palette_shift);
+#ifdef GSVECTOR_HAS_FAST_INT_SHUFFLE8
+        texture_color = LookupCLUT4Vector(pv.clut4_lo, pv.clut4_hi, palette_indices);
+#else
+        texture_color = LookupCLUTVector(palette_indices);
+#endif
       }
       break;
 
@@ -547,8 +620,9 @@ ALWAYS_INLINE_RELEASE static void ShadePixel(const PixelVectors<texture_enable>&
         load_texcoord_x = load_texcoord_x & coord_mask_x;
 
         const GSVectorNi palette_shift = (texcoord_x & GSVectorNi::cxpr(1)).sll32<3>();
-        const GSVectorNi palette_indices = GatherVector(load_texcoord_x, texcoord_y);
-        texture_color = GatherCLUTVector<0xFF>(palette_indices, palette_shift);
+        const GSVectorNi palette_indices =
+          GetCLUTIndices<0xFF>(GatherVector(load_texcoord_x, texcoord_y), palette_shift);
+        texture_color = LookupCLUTVector(palette_indices);
       }
       break;
 
@@ -703,6 +777,219 @@ ALWAYS_INLINE_RELEASE static void ShadePixel(const PixelVectors<texture_enable>&
   StoreVector(start_x, y, color);
 }
 
+ALWAYS_INLINE_RELEASE static bool IsRectangleLineVisible(const GPUBackendDrawRectangleCommand* RESTRICT cmd,
+                                                         const GPUDrawingArea& drawing_area, s32 y)
+{
+  return (y >= static_cast<s32>(drawing_area.top) && y <= static_cast<s32>(drawing_area.bottom) &&
+          (!cmd->interlaced_rendering ||
+           cmd->active_line_lsb != GetTargetLineLSB(y)));
+}
+
+// Untextured rectangle without blending or mask testing, every pixel inside the drawing area is the same colour.
+static void FillRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
+{
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
+  const s32 left = std::max(cmd->x, static_cast<s32>(drawing_area.left));
+  const s32 right = std::min(cmd->x + static_cast<s32>(cmd->width) - 1, static_cast<s32>(drawing_area.right));
+  if (left > right)
+    return;
+
+  // Rectangles aren't dithered, so this is the same as the truncation in ShadePixel().
+  const u16 color16 = VRAMRGBA8888ToRGBA5551(cmd->color & 0xFFFFFFu) | cmd->GetMaskOR();
+  const GSVector4i fill = GSVector4i(color16, color16, color16, color16, color16, color16, color16, color16);
+  constexpr u32 vector_width = 8;
+  const u32 width = static_cast<u32>(right - left) + 1;
+  const u32 aligned_width = Common::AlignDownPow2(width, vector_width);
+
+  for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
+  {
+    const s32 y = cmd->y + static_cast<s32>(offset_y);
+    if (!IsRectangleLineVisible(cmd, drawing_area, y))
+      continue;
+
+    u16* RESTRICT row_ptr =
+      &GetTargetVRAM()[(static_cast<u32>(y) & GetTargetHeightMask()) * GetTargetWidth() + static_cast<u32>(left)];
+    u32 xoffs = 0;
+    for (; xoffs < aligned_width; xoffs += vector_width, row_ptr += vector_width)
+      GSVector4i::store<false>(row_ptr, fill);
+    for (; xoffs < width; xoffs++)
+      *(row_ptr++) = color16;
+  }
+}
+
+#ifndef USE_SCALED_TARGET
+
+ALWAYS_INLINE_RELEASE static GSVectorNi WidenTexelBytes(GSVector4i bytes)
+{
+#ifdef GSVECTOR_HAS_256
+  return GSVector8i::u8to32(bytes);
+#else
+  return bytes.u8to32();
+#endif
+}
+
+// Loads PIXELS_PER_VEC texels starting at u from a line of the texture page, when they're contiguous in VRAM.
+template<GPUTextureMode texture_mode>
+ALWAYS_INLINE_RELEASE static bool LoadSpriteTexels(const PixelVectors<true>& RESTRICT pv, u32 page_x, u32 src_y, u32 u,
+                                                   GSVectorNi* texels)
+{
+  if constexpr (texture_mode == GPUTextureMode::Palette4Bit || texture_mode == GPUTextureMode::Palette8Bit)
+  {
+    // Always loads PIXELS_PER_VEC bytes, which covers up to two texels per byte, plus one for an odd start.
+    const u32 byte_offset = page_x * 2 + ((texture_mode == GPUTextureMode::Palette4Bit) ? (u / 2) : u);
+    if ((byte_offset + PIXELS_PER_VEC) > (VRAM_WIDTH * 2))
+      return false;
+
+    const u8* ptr = reinterpret_cast<const u8*>(&g_vram[src_y * VRAM_WIDTH]) + byte_offset;
+#ifdef GSVECTOR_HAS_256
+    GSVector4i bytes = GSVector4i::loadl<false>(ptr);
+#else
+    GSVector4i bytes = GSVector4i::load32(ptr);
+#endif
+
+    if constexpr (texture_mode == GPUTextureMode::Palette4Bit)
+    {
+      // Duplicate each byte for both of its texels, low nibble first.
+      static constexpr GSVector4i even = GSVector4i::cxpr8(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+      static constexpr GSVector4i odd = GSVector4i::cxpr8(0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8);
+      bytes = bytes.shuffle8((u & 1) ? odd : even);
+
+      const GSVectorNi shifts = (GSVectorNi(u).add32(SPAN_OFFSET_VEC) & GSVectorNi::cxpr(1)).sll32<2>();
+      const GSVectorNi indices = GetCLUTIndices<0x0F>(WidenTexelBytes(bytes), shifts);
+#ifdef GSVECTOR_HAS_FAST_INT_SHUFFLE8
+      *texels = LookupCLUT4Vector(pv.clut4_lo, pv.clut4_hi, indices);
+#else
+      *texels = LookupCLUTVector(indices);
+#endif
+    }
+    else
+    {
+      *texels = LookupCLUTVector(WidenTexelBytes(bytes));
+    }
+  }
+  else
+  {
+    // LoadVector() handles wrapping around the end of the line.
+    *texels = LoadVector(page_x + u, src_y);
+  }
+
+  return true;
+}
+
+// Textured rectangle without blending or mask testing, and without colour modulation, reading the texels for each
+// line directly instead of gathering them. Falls back to ShadePixel() where the texels wrap.
+template<GPUTextureMode texture_mode>
+static void DrawRawSprite(const GPUBackendDrawRectangleCommand* RESTRICT cmd, const PixelVectors<true>& RESTRICT pv)
+{
+  const s32 origin_x = cmd->x;
+  const s32 origin_y = cmd->y;
+  const u32 width = cmd->width;
+  const u32 texcoord_x = cmd->texcoord & 0xFF;
+  u32 texcoord_y = cmd->texcoord >> 8;
+  const u32 page_x = cmd->draw_mode.GetTexturePageBaseX();
+  const u32 page_y = cmd->draw_mode.GetTexturePageBaseY();
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
+
+  for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
+  {
+    const s32 y = origin_y + static_cast<s32>(offset_y);
+    if (IsRectangleLineVisible(cmd, drawing_area, y))
+    {
+      const u32 draw_y = static_cast<u32>(y) & VRAM_HEIGHT_MASK;
+      const u32 src_y = (page_y + ((texcoord_y & cmd->window.and_y) | cmd->window.or_y)) & VRAM_HEIGHT_MASK;
+
+      GSVectorNi xvec = GSVectorNi(origin_x).add32(SPAN_OFFSET_VEC);
+      GSVectorNi wvec = GSVectorNi(width).sub32(SPAN_WIDTH_VEC);
+
+      for (u32 offset_x = 0; offset_x < width; offset_x += PIXELS_PER_VEC)
+      {
+        const s32 x = origin_x + static_cast<s32>(offset_x);
+
+        // width test
+        GSVectorNi preserve_mask = wvec.lt32(GSVectorNi::zero());
+
+        // clip test, if all pixels are outside, skip
+        preserve_mask = preserve_mask | xvec.lt32(pv.clip_left);
+        preserve_mask = preserve_mask | xvec.gt32(pv.clip_right);
+        if (!preserve_mask.alltrue())
+        {
+          const u32 u = (texcoord_x + offset_x) & 0xFF;
+          GSVectorNi texels;
+          if ((u + PIXELS_PER_VEC) <= 256 && LoadSpriteTexels<texture_mode>(pv, page_x, src_y, u, &texels))
+          {
+            // zero texels are transparent
+            preserve_mask = preserve_mask | texels.eq32(GSVectorNi::zero());
+            if (!preserve_mask.alltrue())
+            {
+              GSVectorNi color = texels | pv.mask_or;
+              if (!preserve_mask.allfalse())
+                color = color.blend8(LoadVector(x, draw_y), preserve_mask);
+
+              StoreVector(x, draw_y, color);
+            }
+          }
+          else
+          {
+            ShadePixel<true, true, false>(pv, texture_mode, cmd->draw_mode.transparency_mode, false, x, draw_y,
+                                          GSVectorNi::zero(), GSVectorNi::zero(), GSVectorNi(u).add32(SPAN_OFFSET_VEC),
+                                          GSVectorNi(texcoord_y), preserve_mask, GSVectorNi::zero());
+          }
+        }
+
+        xvec = xvec.add32(PIXELS_PER_VEC_VEC);
+        wvec = wvec.sub32(PIXELS_PER_VEC_VEC);
+      }
+    }
+
+    texcoord_y = (texcoord_y + 1) & 0xFF;
+  }
+}
+
+#endif // USE_SCALED_TARGET
+
+// Sprites which don't blend or test the mask bit are common enough in 2D games to be worth skipping the general
+// shading path for. Modulating by 0x808080 leaves the texture colour unchanged, so those are treated as raw.
+template<bool texture_enable, bool raw_texture_enable>
+ALWAYS_INLINE_RELEASE static bool TryDrawSprite(const GPUBackendDrawRectangleCommand* RESTRICT cmd,
+                                                const PixelVectors<texture_enable>& RESTRICT pv)
+{
+  if constexpr (!texture_enable)
+  {
+    FillRectangle(cmd);
+    return true;
+  }
+  else
+  {
+#ifdef USE_SCALED_TARGET
+    // Each texel covers several pixels, so the texels can't be stored directly.
+    return false;
+#else
+    if ((!raw_texture_enable && (cmd->color & 0xFFFFFFu) != 0x808080u) || cmd->window.and_x != 0xFF ||
+        cmd->window.or_x != 0)
+    {
+      return false;
+    }
+
+    switch (cmd->draw_mode.texture_mode)
+    {
+      case GPUTextureMode::Palette4Bit:
+        DrawRawSprite<GPUTextureMode::Palette4Bit>(cmd, pv);
+        break;
+
+      case GPUTextureMode::Palette8Bit:
+        DrawRawSprite<GPUTextureMode::Palette8Bit>(cmd, pv);
+        break;
+
+      default:
+        DrawRawSprite<GPUTextureMode::Direct16Bit>(cmd, pv);
+        break;
+    }
+
+    return true;
+#endif
+  }
+}
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
 static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
 {
@@ -715,26 +1002,42 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
   const GSVectorNi rg = GSVectorNi::broadcast128(rgp.u8to16()); // R0G0 | R0G0 | R0G0 | R0G0
   const GSVectorNi ba = GSVectorNi::broadcast128(bap.u8to16()); // B0A0 | B0A0 | B0A0 | B0A0
 
-  const GSVectorNi texcoord_x = GSVectorNi(cmd->texcoord & 0xFF).add32(SPAN_OFFSET_VEC);
+  // Texture coordinates advance once per texel, which covers several pixels when scaled. Scales are at most the
+  // vector width, so each vector starts on a texel boundary.
+  const u32 texcoord_shift = GetTargetShift();
+  const GSVectorNi texcoord_x = GSVectorNi(cmd->texcoord & 0xFF).add32(SPAN_OFFSET_VEC.srl32(texcoord_shift));
+  const GSVectorNi texcoord_x_step = PIXELS_PER_VEC_VEC.srl32(texcoord_shift);
+  const u32 texcoord_y_step_mask = (1u << texcoord_shift) - 1;
   GSVectorNi texcoord_y = GSVectorNi(cmd->texcoord >> 8);
 
   const PixelVectors<texture_enable> pv(cmd);
   const u32 width = cmd->width;
   const GPUTransparencyMode transparency_mode = cmd->draw_mode.transparency_mode;
   const bool mask_bit_test = cmd->check_mask_before_draw;
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
 
 #ifdef CHECK_VECTOR
   BACKUP_VRAM();
 #endif
 
+  if constexpr (!transparency_enable)
+  {
+    if (!mask_bit_test && TryDrawSprite<texture_enable, raw_texture_enable>(cmd, pv))
+    {
+#ifdef CHECK_VECTOR
+      CHECK_VRAM(
+        GPU_SW_Rasterizer::DrawRectangleFunctions[texture_enable][raw_texture_enable][transparency_enable](cmd));
+#endif
+      return;
+    }
+  }
+
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y >= static_cast<s32>(g_drawing_area.top) && y <= static_cast<s32>(g_drawing_area.bottom) &&
-        (!cmd->interlaced_rendering ||
-         cmd->active_line_lsb != ConvertToBoolUnchecked(Truncate8(static_cast<u32>(y)) & 1u)))
+    if (IsRectangleLineVisible(cmd, drawing_area, y))
     {
-      const s32 draw_y = (y & VRAM_HEIGHT_MASK);
+      const s32 draw_y = (y & GetTargetHeightMask());
 
       GSVectorNi row_texcoord_x = texcoord_x;
       GSVectorNi xvec = GSVectorNi(origin_x).add32(SPAN_OFFSET_VEC);
@@ -761,12 +1064,15 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
         wvec = wvec.sub32(PIXELS_PER_VEC_VEC);
 
         if constexpr (texture_enable)
-          row_texcoord_x = row_texcoord_x.add32(PIXELS_PER_VEC_VEC) & GSVectorNi::cxpr(0xFF);
+          row_texcoord_x = row_texcoord_x.add32(texcoord_x_step) & GSVectorNi::cxpr(0xFF);
       }
     }
 
     if constexpr (texture_enable)
-      texcoord_y = texcoord_y.add32(GSVectorNi::cxpr(1)) & GSVectorNi::cxpr(0xFF);
+    {
+      if (((offset_y + 1) & texcoord_y_step_mask) == 0)
+        texcoord_y = texcoord_y.add32(GSVectorNi::cxpr(1)) & GSVectorNi::cxpr(0xFF);
+    }
   }
 
 #ifdef CHECK_VECTOR
@@ -784,7 +1090,7 @@ static void DrawLine(const GPUBackendDrawCommand* RESTRICT cmd, const GPUBackend
   static constexpr u32 XY_SHIFT = 32;
   static constexpr u32 RGB_SHIFT = 12;
   static constexpr auto makefp_xy = [](s32 x) { return (static_cast<s64>(x) << XY_SHIFT) | (1LL << (XY_SHIFT - 1)); };
-  static constexpr auto unfp_xy = [](s64 x) { return TruncateGPUVertexPosition(static_cast<s32>(x >> XY_SHIFT)); };
+  static constexpr auto unfp_xy = [](s64 x) { return TruncateTargetPosition(static_cast<s32>(x >> XY_SHIFT)); };
   static constexpr auto div_xy = [](s64 delta, s32 dk) {
     return ((delta << XY_SHIFT) - ((delta < 0) ? (dk - 1) : 0) + ((delta > 0) ? (dk - 1) : 0)) / dk;
   };
@@ -797,7 +1103,8 @@ static void DrawLine(const GPUBackendDrawCommand* RESTRICT cmd, const GPUBackend
   const s32 i_dx = std::abs(p1->x - p0->x);
   const s32 i_dy = std::abs(p1->y - p0->y);
   const s32 k = (i_dx > i_dy) ? i_dx : i_dy;
-  if (i_dx >= MAX_PRIMITIVE_WIDTH || i_dy >= MAX_PRIMITIVE_HEIGHT) [[unlikely]]
+  if (i_dx >= static_cast<s32>(MAX_PRIMITIVE_WIDTH << GetTargetShift()) ||
+      i_dy >= static_cast<s32>(MAX_PRIMITIVE_HEIGHT << GetTargetShift())) [[unlikely]]
     return;
 
   if (p0->x >= p1->x && k > 0)
@@ -827,22 +1134,23 @@ static void DrawLine(const GPUBackendDrawCommand* RESTRICT cmd, const GPUBackend
     curb = makefp_rgb(p0->b);
   }
 
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
   for (s32 i = 0; i <= k; i++)
   {
     const s32 x = unfp_xy(curx);
     const s32 y = unfp_xy(cury);
 
     if ((!cmd->interlaced_rendering ||
-         cmd->active_line_lsb != ConvertToBoolUnchecked(Truncate8(static_cast<u32>(y)) & 1u)) &&
-        x >= static_cast<s32>(g_drawing_area.left) && x <= static_cast<s32>(g_drawing_area.right) &&
-        y >= static_cast<s32>(g_drawing_area.top) && y <= static_cast<s32>(g_drawing_area.bottom))
+         cmd->active_line_lsb != GetTargetLineLSB(y)) &&
+        x >= static_cast<s32>(drawing_area.left) && x <= static_cast<s32>(drawing_area.right) &&
+        y >= static_cast<s32>(drawing_area.top) && y <= static_cast<s32>(drawing_area.bottom))
     {
       const u8 r = shading_enable ? unfp_rgb(curr) : p0->r;
       const u8 g = shading_enable ? unfp_rgb(curg) : p0->g;
       const u8 b = shading_enable ? unfp_rgb(curb) : p0->b;
 
-      ShadePixel<false, false, transparency_enable>(cmd, static_cast<u32>(x), static_cast<u32>(y) & VRAM_HEIGHT_MASK, r,
-                                                    g, b, 0, 0);
+      ShadePixel<false, false, transparency_enable>(cmd, static_cast<u32>(x), static_cast<u32>(y) & GetTargetHeightMask(),
+                                                    r, g, b, 0, 0);
     }
 
     curx += dxdk;
@@ -987,20 +1295,21 @@ template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool
 static void DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_start, s32 x_bound, UVStepper uv,
                      const UVSteps& RESTRICT uvstep, RGBStepper rgb, const RGBSteps& RESTRICT rgbstep)
 {
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
   s32 width = x_bound - x_start;
-  s32 current_x = TruncateGPUVertexPosition(x_start);
+  s32 current_x = TruncateTargetPosition(x_start);
 
   // Skip pixels outside of the scissor rectangle.
-  if (current_x < static_cast<s32>(g_drawing_area.left))
+  if (current_x < static_cast<s32>(drawing_area.left))
   {
-    const s32 delta = static_cast<s32>(g_drawing_area.left) - current_x;
+    const s32 delta = static_cast<s32>(drawing_area.left) - current_x;
     x_start += delta;
     current_x += delta;
     width -= delta;
   }
 
-  if ((current_x + width) > (static_cast<s32>(g_drawing_area.right) + 1))
-    width = static_cast<s32>(g_drawing_area.right) + 1 - current_x;
+  if ((current_x + width) > (static_cast<s32>(drawing_area.right) + 1))
+    width = static_cast<s32>(drawing_area.right) + 1 - current_x;
 
   if (width <= 0)
     return;
@@ -1037,6 +1346,7 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
   u64 left_x = tp.start_x[0];
   u64 right_x = tp.start_x[1];
   s32 current_y = tp.start_y;
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
 
   if (tp.fill_upside_down)
   {
@@ -1057,8 +1367,8 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       left_x -= left_x_step;
       right_x -= right_x_step;
 
-      const s32 y = TruncateGPUVertexPosition(current_y);
-      if (y < static_cast<s32>(g_drawing_area.top))
+      const s32 y = TruncateTargetPosition(current_y);
+      if (y < static_cast<s32>(drawing_area.top))
         break;
 
       // Opposite direction means we need to subtract when stepping instead of adding.
@@ -1067,15 +1377,15 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       if constexpr (shading_enable)
         lrgb.StepY<true>(rgbstep);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom) ||
+      if (y > static_cast<s32>(drawing_area.bottom) ||
           (cmd->interlaced_rendering &&
-           cmd->active_line_lsb == ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
+           cmd->active_line_lsb == GetTargetLineLSB(current_y)))
       {
         continue;
       }
 
       DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable>(
-        cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
+        cmd, y & GetTargetHeightMask(), unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
     } while (current_y > end_y);
   }
   else
@@ -1093,18 +1403,18 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
 
     do
     {
-      const s32 y = TruncateGPUVertexPosition(current_y);
+      const s32 y = TruncateTargetPosition(current_y);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom))
+      if (y > static_cast<s32>(drawing_area.bottom))
       {
         break;
       }
-      if (y >= static_cast<s32>(g_drawing_area.top) &&
+      if (y >= static_cast<s32>(drawing_area.top) &&
           (!cmd->interlaced_rendering ||
-           cmd->active_line_lsb != ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
+           cmd->active_line_lsb != GetTargetLineLSB(current_y)))
       {
         DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable>(
-          cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
+          cmd, y & GetTargetHeightMask(), unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
       }
 
       current_y++;
@@ -1169,20 +1479,21 @@ ALWAYS_INLINE_RELEASE static void DrawSpan(const GPUBackendDrawCommand* RESTRICT
                                            const RGBSteps& RESTRICT rgbstep,
                                            const TriangleVectors<shading_enable, texture_enable>& RESTRICT tv)
 {
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
   s32 width = x_bound - x_start;
-  s32 current_x = TruncateGPUVertexPosition(x_start);
+  s32 current_x = TruncateTargetPosition(x_start);
 
   // Skip pixels outside of the scissor rectangle.
-  if (current_x < static_cast<s32>(g_drawing_area.left))
+  if (current_x < static_cast<s32>(drawing_area.left))
   {
-    const s32 delta = static_cast<s32>(g_drawing_area.left) - current_x;
+    const s32 delta = static_cast<s32>(drawing_area.left) - current_x;
     x_start += delta;
     current_x += delta;
     width -= delta;
   }
 
-  if ((current_x + width) > (static_cast<s32>(g_drawing_area.right) + 1))
-    width = static_cast<s32>(g_drawing_area.right) + 1 - current_x;
+  if ((current_x + width) > (static_cast<s32>(drawing_area.right) + 1))
+    width = static_cast<s32>(drawing_area.right) + 1 - current_x;
 
   if (width <= 0)
     return;
@@ -1286,6 +1597,7 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
   u64 left_x = tp.start_x[0];
   u64 right_x = tp.start_x[1];
   s32 current_y = tp.start_y;
+  const GPUDrawingArea& drawing_area = *g_thread_drawing_area;
 
   if (tp.fill_upside_down)
   {
@@ -1308,8 +1620,8 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       left_x -= left_x_step;
       right_x -= right_x_step;
 
-      const s32 y = TruncateGPUVertexPosition(current_y);
-      if (y < static_cast<s32>(g_drawing_area.top))
+      const s32 y = TruncateTargetPosition(current_y);
+      if (y < static_cast<s32>(drawing_area.top))
         break;
 
       // Opposite direction means we need to subtract when stepping instead of adding.
@@ -1318,15 +1630,15 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       if constexpr (shading_enable)
         lrgb.StepY<true>(rgbstep);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom) ||
+      if (y > static_cast<s32>(drawing_area.bottom) ||
           (cmd->interlaced_rendering &&
-           cmd->active_line_lsb == ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
+           cmd->active_line_lsb == GetTargetLineLSB(current_y)))
       {
         continue;
       }
 
       DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable>(
-        cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
+        cmd, y & GetTargetHeightMask(), unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
     } while (current_y > end_y);
   }
   else
@@ -1346,18 +1658,18 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
 
     do
     {
-      const s32 y = TruncateGPUVertexPosition(current_y);
+      const s32 y = TruncateTargetPosition(current_y);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom))
+      if (y > static_cast<s32>(drawing_area.bottom))
       {
         break;
       }
-      if (y >= static_cast<s32>(g_drawing_area.top) &&
+      if (y >= static_cast<s32>(drawing_area.top) &&
           (!cmd->interlaced_rendering ||
-           cmd->active_line_lsb != ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
+           cmd->active_line_lsb != GetTargetLineLSB(current_y)))
       {
         DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable>(
-          cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
+          cmd, y & GetTargetHeightMask(), unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
       }
 
       current_y++;
@@ -1451,7 +1763,13 @@ static void DrawTriangle(const GPUBackendDrawCommand* RESTRICT cmd,
   tpp.fill_upside_down = (vp != 0);
 
 #define ATTRIB_DETERMINANT(x, y) (((v1->x - v0->x) * (v2->y - v1->y)) - ((v2->x - v1->x) * (v1->y - v0->y)))
+#ifdef USE_SCALED_TARGET
+  // Scaled positions are large enough to overflow the intermediate.
+#define ATTRIB_STEP(x, y)                                                                                              \
+  (static_cast<u32>(static_cast<s64>(ATTRIB_DETERMINANT(x, y)) * (1 << ATTRIB_SHIFT) / det) << ATTRIB_POST_SHIFT)
+#else
 #define ATTRIB_STEP(x, y) (static_cast<u32>(ATTRIB_DETERMINANT(x, y) * (1 << ATTRIB_SHIFT) / det) << ATTRIB_POST_SHIFT)
+#endif
 
   // Check edges.
   const s32 det = ATTRIB_DETERMINANT(x, y);
@@ -1544,7 +1862,10 @@ constinit const DrawTriangleFunctionTable DrawTriangleFunctions = {
    {{&DrawTriangle<true, true, false, false>, &DrawTriangle<true, true, false, true>},
     {&DrawTriangle<true, true, true, false>, &DrawTriangle<true, true, true, true>}}}};
 
-static void FillVRAMImpl(u32 x, u32 y, u32 width, u32 height, u32 color, bool interlaced, u8 active_line_lsb)
+// VRAM transfers always operate on native VRAM, the scaled copy is updated by the caller.
+#ifndef USE_SCALED_TARGET
+
+void FillVRAMImpl(u32 x, u32 y, u32 width, u32 height, u32 color, bool interlaced, u8 active_line_lsb)
 {
 #ifdef USE_VECTOR
   const u16 color16 = VRAMRGBA8888ToRGBA5551(color);
@@ -1662,8 +1983,8 @@ static void FillVRAMImpl(u32 x, u32 y, u32 width, u32 height, u32 color, bool in
 #endif
 }
 
-static void WriteVRAMImpl(u32 x, u32 y, u32 width, u32 height, const void* RESTRICT data, bool set_mask,
-                          bool check_mask)
+void WriteVRAMImpl(u32 x, u32 y, u32 width, u32 height, const void* RESTRICT data, bool set_mask,
+                   bool check_mask)
 {
   // Fast path when the copy is not oversized.
   if ((x + width) <= VRAM_WIDTH && (y + height) <= VRAM_HEIGHT && !set_mask && !check_mask)
@@ -1738,8 +2059,8 @@ static void WriteVRAMImpl(u32 x, u32 y, u32 width, u32 height, const void* RESTR
   }
 }
 
-static void CopyVRAMImpl(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask,
-                         bool check_mask)
+void CopyVRAMImpl(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask,
+                  bool check_mask)
 {
   // Break up oversized copies. This behavior has not been verified on console.
   if ((src_x + width) > VRAM_WIDTH || (dst_x + width) > VRAM_WIDTH)
@@ -1846,6 +2167,8 @@ static void CopyVRAMImpl(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width,
   }
 }
 
+#endif // USE_SCALED_TARGET
+
 #ifdef __INTELLISENSE__
 }
 #endif
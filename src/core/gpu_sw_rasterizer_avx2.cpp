@@ -3,10 +3,46 @@
 
 #include "gpu_sw_rasterizer.h"
 
+#include "common/align.h"
 #include "common/assert.h"
 #include "common/gsvector.h"
 
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#ifdef GPU_SW_RASTERIZER_ENABLE_AVX2
+
+// Everything above is shared with the rest of the program, so it has to stay compiled for the base ISA. Only the code
+// below is compiled for AVX2, using target attributes instead of compiler flags, and it gets its own copy of GSVector,
+// otherwise the linker could pick the AVX2 version of an inline function for the whole program.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
 namespace GPU_SW_Rasterizer::AVX2 {
+
+#ifndef CPU_ARCH_AVX
+#define CPU_ARCH_AVX 1
+#endif
+#define CPU_ARCH_AVX2 1
+#define GSVECTOR_INCLUDE_FOR_ISA 1
+#include "common/gsvector_sse.h"
+#undef GSVECTOR_INCLUDE_FOR_ISA
+
 #define USE_VECTOR 1
 #include "gpu_sw_rasterizer.inl"
-}
+#undef USE_VECTOR
+
+} // namespace GPU_SW_Rasterizer::AVX2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // GPU_SW_RASTERIZER_ENABLE_AVX2
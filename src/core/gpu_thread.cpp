@@ -321,7 +321,13 @@ ALWAYS_INLINE_RELEASE void GPUThread::WakeGPUThreadIfSleeping()
 void GPUThread::SyncGPUThread(bool spin)
 {
   if (!s_state.use_gpu_thread)
+  {
+    // Commands have already been executed, but the backend could still be rendering them on other threads.
+    if (s_state.gpu_backend)
+      s_state.gpu_backend->OnCommandFIFOEmpty();
+
     return;
+  }
 
   if (spin)
   {
@@ -420,6 +426,9 @@ void GPUThread::Internal::GPUThreadEntryPoint()
     u32 read_ptr = s_state.command_fifo_read_ptr.load(std::memory_order_relaxed);
     if (read_ptr == write_ptr)
     {
+      if (s_state.gpu_backend)
+        s_state.gpu_backend->OnCommandFIFOEmpty();
+
       if (SleepGPUThread(!s_state.run_idle_flag))
       {
         // sleep => wake, need to reload pointers
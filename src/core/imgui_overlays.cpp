@@ -109,7 +109,9 @@ static void UpdateInputOverlay(void* buffer);
 
 #ifndef __ANDROID__
 
-static constexpr size_t NUM_DEBUG_WINDOWS = 7;
+static void DrawMemorySaveStateDebugWindow(float scale);
+
+static constexpr size_t NUM_DEBUG_WINDOWS = 8;
 static constexpr const char* DEBUG_WINDOW_CONFIG_SECTION = "DebugWindows";
 static constexpr const std::array<DebugWindowInfo, NUM_DEBUG_WINDOWS> s_debug_window_info = {{
   {"Freecam", "Free Camera", ":icons/applications-system.png", &GTE::DrawFreecamWindow, 510, 500},
@@ -119,6 +121,8 @@ static constexpr const std::array<DebugWindowInfo, NUM_DEBUG_WINDOWS> s_debug_wi
   {"DMA", "DMA State", ":icons/applications-system.png", &DMA::DrawDebugStateWindow, 860, 180},
   {"MDEC", "MDEC State", ":icons/applications-system.png", &MDEC::DrawDebugStateWindow, 300, 350},
   {"Timers", "Timers State", ":icons/applications-system.png", &Timers::DrawDebugStateWindow, 800, 95},
+  {"MemorySaveStates", "Rewind/Runahead State Timing", ":icons/applications-system.png",
+   &DrawMemorySaveStateDebugWindow, 500, 420},
 }};
 static std::array<ImGuiManager::AuxiliaryRenderWindowState, NUM_DEBUG_WINDOWS> s_debug_window_state = {};
 
@@ -231,6 +235,68 @@ void ImGuiManager::DestroyAllDebugWindows()
 #endif
 }
 
+#ifndef __ANDROID__
+
+void ImGuiManager::DrawMemorySaveStateDebugWindow(float scale)
+{
+  using PerformanceCounters::MemorySaveStateComponent;
+
+  static constexpr u32 NUM_COLUMNS = 4;
+  static constexpr std::array<const char*, NUM_COLUMNS> column_names = {{"Component", "Size", "Save", "Load"}};
+
+  ImGui::Text("Save: %.3f ms/frame (%.3f ms/frame async)", PerformanceCounters::GetAverageMemorySaveStateTime(),
+              PerformanceCounters::GetAverageAsyncMemorySaveStateTime());
+  ImGui::Separator();
+
+  ImGui::Columns(NUM_COLUMNS);
+  ImGui::SetColumnWidth(0, 170.0f * scale);
+  ImGui::SetColumnWidth(1, 100.0f * scale);
+  ImGui::SetColumnWidth(2, 100.0f * scale);
+  ImGui::SetColumnWidth(3, 100.0f * scale);
+
+  for (const char* title : column_names)
+  {
+    ImGui::TextUnformatted(title);
+    ImGui::NextColumn();
+  }
+
+  float total_save_time = 0.0f;
+  float total_load_time = 0.0f;
+  u32 total_size = 0;
+  for (u32 i = 0; i < static_cast<u32>(MemorySaveStateComponent::MaxCount); i++)
+  {
+    const MemorySaveStateComponent component = static_cast<MemorySaveStateComponent>(i);
+    const PerformanceCounters::MemorySaveStateComponentStats& stats =
+      PerformanceCounters::GetMemorySaveStateComponentStats(component);
+    total_save_time += stats.average_save_time;
+    total_load_time += stats.average_load_time;
+    total_size += stats.size;
+
+    ImGui::TextUnformatted(PerformanceCounters::GetMemorySaveStateComponentName(component));
+    ImGui::NextColumn();
+    ImGui::Text("%u", stats.size);
+    ImGui::NextColumn();
+    ImGui::Text("%.1f us", stats.average_save_time);
+    ImGui::NextColumn();
+    ImGui::Text("%.1f us", stats.average_load_time);
+    ImGui::NextColumn();
+  }
+
+  ImGui::Separator();
+  ImGui::TextUnformatted("Total");
+  ImGui::NextColumn();
+  ImGui::Text("%u", total_size);
+  ImGui::NextColumn();
+  ImGui::Text("%.1f us", total_save_time);
+  ImGui::NextColumn();
+  ImGui::Text("%.1f us", total_load_time);
+  ImGui::NextColumn();
+
+  ImGui::Columns(1);
+}
+
+#endif
+
 void ImGuiManager::RenderTextOverlays(const GPUBackend* gpu)
 {
   // Don't draw anything with loading screen open, it'll be nonsensical.
@@ -739,9 +805,44 @@ void ImGuiManager::DrawFrameTimeOverlay(float& position_y, float scale, float ma
       },
       nullptr, PerformanceCounters::NUM_FRAME_TIME_SAMPLES, 0, nullptr, min, max, history_size);
 
+    // Rewind/runahead save time on the CPU thread, relative to the frame time.
+    float save_max;
+    {
+      const PerformanceCounters::FrameTimeHistory& history = PerformanceCounters::GetMemorySaveStateTimeHistory();
+      GSVector4 vmax = GSVector4::load<true>(history.data());
+      for (size_t i = 4; i < history.size(); i += 4)
+        vmax = vmax.max(GSVector4::load<true>(&history[i]));
+      save_max = vmax.maxv();
+    }
+    if (save_max > 0.0f)
+    {
+      ImGui::SetCursorPos(ImVec2(0.0f, 0.0f));
+      ImGui::PushStyleColor(ImGuiCol_PlotLines, ImVec4(1.0f, 0.6f, 0.0f, 1.0f));
+      ImGui::PlotEx(
+        ImGuiPlotType_Lines, "##memory_save_state_times",
+        [](void*, int idx) -> float {
+          return PerformanceCounters::GetMemorySaveStateTimeHistory()[(
+            (PerformanceCounters::GetFrameTimeHistoryPos() + idx) % PerformanceCounters::NUM_FRAME_TIME_SAMPLES)];
+        },
+        nullptr, PerformanceCounters::NUM_FRAME_TIME_SAMPLES, 0, nullptr, 0.0f, max, history_size);
+      ImGui::PopStyleColor();
+    }
+
     ImDrawList* win_dl = ImGui::GetCurrentWindow()->DrawList;
     const ImVec2 wpos(ImGui::GetCurrentWindow()->Pos);
 
+    if (save_max > 0.0f)
+    {
+      // Frame time spent saving, and compression time moved off the frame.
+      TinyString save_text;
+      save_text.format("Save {:.1f}/{:.1f} ms", PerformanceCounters::GetAverageMemorySaveStateTime(),
+                       PerformanceCounters::GetAverageAsyncMemorySaveStateTime());
+      win_dl->AddText(ImVec2(wpos.x + spacing + shadow_offset, wpos.y + shadow_offset), IM_COL32(0, 0, 0, 100),
+                      save_text.c_str(), save_text.end_ptr());
+      win_dl->AddText(ImVec2(wpos.x + spacing, wpos.y), IM_COL32(255, 153, 0, 255), save_text.c_str(),
+                      save_text.end_ptr());
+    }
+
     TinyString text;
     text.format("{:.1f} ms", max);
     ImVec2 text_size = fixed_font->CalcTextSizeA(fixed_font_size, -1.0f, FLT_MAX, 0.0f, text.c_str(), text.end_ptr());
@@ -1052,6 +1153,8 @@ void SaveStateSelectorUI::RefreshList()
 
     s_state.slots.push_back(std::move(li));
   }
+
+  System::FlushSaveStateIndex();
 }
 
 void SaveStateSelectorUI::Clear()
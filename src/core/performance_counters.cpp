@@ -14,6 +14,7 @@
 #include "common/threading.h"
 #include "common/timer.h"
 
+#include <atomic>
 #include <utility>
 
 LOG_CHANNEL(PerfMon);
@@ -55,8 +56,17 @@ struct State
   float accumulated_gpu_time;
   float gpu_usage;
 
+  float memory_save_state_time_accumulator;
+  float async_memory_save_state_time_accumulator;
+  float average_memory_save_state_time;
+  float average_async_memory_save_state_time;
+
   alignas(VECTOR_ALIGNMENT) FrameTimeHistory frame_time_history;
+  alignas(VECTOR_ALIGNMENT) FrameTimeHistory memory_save_state_time_history;
   u32 frame_time_history_pos;
+
+  std::array<MemorySaveStateComponentStats, static_cast<size_t>(MemorySaveStateComponent::MaxCount)>
+    memory_save_state_component_stats;
 };
 
 } // namespace
@@ -65,6 +75,36 @@ static constexpr const float PERFORMANCE_COUNTER_UPDATE_INTERVAL = 1.0f;
 
 ALIGN_TO_CACHE_LINE State s_state = {};
 
+// Written from the CPU thread and compression workers, in nanoseconds.
+static std::atomic<u64> s_pending_memory_save_state_time{0};
+static std::atomic<u64> s_pending_async_memory_save_state_time{0};
+
+// Written from the CPU and GPU threads, in timer ticks.
+static std::array<std::atomic<u64>, static_cast<size_t>(MemorySaveStateComponent::MaxCount)>
+  s_pending_component_save_ticks = {};
+static std::array<std::atomic<u64>, static_cast<size_t>(MemorySaveStateComponent::MaxCount)>
+  s_pending_component_load_ticks = {};
+static std::array<std::atomic<u32>, static_cast<size_t>(MemorySaveStateComponent::MaxCount)> s_component_sizes = {};
+
+static constexpr const std::array<const char*, static_cast<size_t>(MemorySaveStateComponent::MaxCount)>
+  s_memory_save_state_component_names = {{
+    "CPU",
+    "PGXP",
+    "Bus",
+    "DMA",
+    "InterruptController",
+    "GPU",
+    "GPU Backend",
+    "CDROM",
+    "Pad",
+    "Timers",
+    "SPU",
+    "MDEC",
+    "SIO",
+    "Events",
+    "Achievements",
+  }};
+
 } // namespace PerformanceCounters
 
 float PerformanceCounters::GetFPS()
@@ -127,16 +167,42 @@ float PerformanceCounters::GetGPUAverageTime()
   return s_state.average_gpu_time;
 }
 
+float PerformanceCounters::GetAverageMemorySaveStateTime()
+{
+  return s_state.average_memory_save_state_time;
+}
+
+float PerformanceCounters::GetAverageAsyncMemorySaveStateTime()
+{
+  return s_state.average_async_memory_save_state_time;
+}
+
 const PerformanceCounters::FrameTimeHistory& PerformanceCounters::GetFrameTimeHistory()
 {
   return s_state.frame_time_history;
 }
 
+const PerformanceCounters::FrameTimeHistory& PerformanceCounters::GetMemorySaveStateTimeHistory()
+{
+  return s_state.memory_save_state_time_history;
+}
+
 u32 PerformanceCounters::GetFrameTimeHistoryPos()
 {
   return s_state.frame_time_history_pos;
 }
 
+const char* PerformanceCounters::GetMemorySaveStateComponentName(MemorySaveStateComponent component)
+{
+  return s_memory_save_state_component_names[static_cast<size_t>(component)];
+}
+
+const PerformanceCounters::MemorySaveStateComponentStats&
+PerformanceCounters::GetMemorySaveStateComponentStats(MemorySaveStateComponent component)
+{
+  return s_state.memory_save_state_component_stats[static_cast<size_t>(component)];
+}
+
 void PerformanceCounters::Clear()
 {
   s_state = {};
@@ -173,6 +239,14 @@ void PerformanceCounters::Update(GPUBackend* gpu, u32 frame_number, u32 internal
   s_state.average_frame_time_accumulator += frame_time;
   s_state.maximum_frame_time_accumulator = std::max(s_state.maximum_frame_time_accumulator, frame_time);
   s_state.frame_time_history[s_state.frame_time_history_pos] = frame_time;
+
+  const float memory_save_state_time =
+    static_cast<float>(s_pending_memory_save_state_time.exchange(0, std::memory_order_relaxed)) / 1000000.0f;
+  s_state.memory_save_state_time_accumulator += memory_save_state_time;
+  s_state.async_memory_save_state_time_accumulator +=
+    static_cast<float>(s_pending_async_memory_save_state_time.exchange(0, std::memory_order_relaxed)) / 1000000.0f;
+  s_state.memory_save_state_time_history[s_state.frame_time_history_pos] = memory_save_state_time;
+
   s_state.frame_time_history_pos = (s_state.frame_time_history_pos + 1) % NUM_FRAME_TIME_SAMPLES;
 
   // update fps counter
@@ -198,6 +272,22 @@ void PerformanceCounters::Update(GPUBackend* gpu, u32 frame_number, u32 internal
   s_state.minimum_frame_time = std::exchange(s_state.minimum_frame_time_accumulator, 0.0f);
   s_state.average_frame_time = std::exchange(s_state.average_frame_time_accumulator, 0.0f) / frames_runf;
   s_state.maximum_frame_time = std::exchange(s_state.maximum_frame_time_accumulator, 0.0f);
+  s_state.average_memory_save_state_time =
+    std::exchange(s_state.memory_save_state_time_accumulator, 0.0f) / frames_runf;
+  s_state.average_async_memory_save_state_time =
+    std::exchange(s_state.async_memory_save_state_time_accumulator, 0.0f) / frames_runf;
+
+  const auto get_average_component_time = [frames_runf](std::atomic<u64>& ticks) {
+    const double us = Timer::ConvertValueToNanoseconds(ticks.exchange(0, std::memory_order_relaxed)) / 1000.0;
+    return static_cast<float>(us) / frames_runf;
+  };
+  for (size_t i = 0; i < static_cast<size_t>(MemorySaveStateComponent::MaxCount); i++)
+  {
+    MemorySaveStateComponentStats& stats = s_state.memory_save_state_component_stats[i];
+    stats.average_save_time = get_average_component_time(s_pending_component_save_ticks[i]);
+    stats.average_load_time = get_average_component_time(s_pending_component_load_ticks[i]);
+    stats.size = s_component_sizes[i].load(std::memory_order_relaxed);
+  }
 
   s_state.vps = static_cast<float>(frames_runf / time);
   s_state.fps = static_cast<float>(internal_frames_run) / time;
@@ -242,3 +332,22 @@ void PerformanceCounters::AccumulateGPUTime()
   s_state.accumulated_gpu_time += g_gpu_device->GetAndResetAccumulatedGPUTime();
   s_state.presents_since_last_update++;
 }
+
+void PerformanceCounters::AccumulateMemorySaveStateTime(double ms)
+{
+  s_pending_memory_save_state_time.fetch_add(static_cast<u64>(ms * 1000000.0), std::memory_order_relaxed);
+}
+
+void PerformanceCounters::AccumulateAsyncMemorySaveStateTime(double ms)
+{
+  s_pending_async_memory_save_state_time.fetch_add(static_cast<u64>(ms * 1000000.0), std::memory_order_relaxed);
+}
+
+void PerformanceCounters::AccumulateMemorySaveStateComponent(MemorySaveStateComponent component, bool is_load,
+                                                             u64 ticks, size_t size)
+{
+  const size_t index = static_cast<size_t>(component);
+  (is_load ? s_pending_component_load_ticks : s_pending_component_save_ticks)[index].fetch_add(
+    ticks, std::memory_order_relaxed);
+  s_component_sizes[index].store(static_cast<u32>(size), std::memory_order_relaxed);
+}
@@ -12,6 +12,34 @@ namespace PerformanceCounters {
 inline constexpr u32 NUM_FRAME_TIME_SAMPLES = 152;
 using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
 
+/// Parts of the system which are timed individually when saving/loading rewind and runahead states.
+enum class MemorySaveStateComponent : u8
+{
+  CPU,
+  PGXP,
+  Bus,
+  DMA,
+  InterruptController,
+  GPU,
+  GPUBackend,
+  CDROM,
+  Pad,
+  Timers,
+  SPU,
+  MDEC,
+  SIO,
+  Events,
+  Achievements,
+  MaxCount
+};
+
+struct MemorySaveStateComponentStats
+{
+  float average_save_time; // microseconds per frame
+  float average_load_time;
+  u32 size;
+};
+
 float GetFPS();
 float GetVPS();
 float GetEmulationSpeed();
@@ -24,12 +52,24 @@ float GetGPUThreadUsage();
 float GetGPUThreadAverageTime();
 float GetGPUUsage();
 float GetGPUAverageTime();
+float GetAverageMemorySaveStateTime();
+float GetAverageAsyncMemorySaveStateTime();
 const FrameTimeHistory& GetFrameTimeHistory();
+const FrameTimeHistory& GetMemorySaveStateTimeHistory();
 u32 GetFrameTimeHistoryPos();
+const char* GetMemorySaveStateComponentName(MemorySaveStateComponent component);
+const MemorySaveStateComponentStats& GetMemorySaveStateComponentStats(MemorySaveStateComponent component);
 
 void Clear();
 void Reset();
 void Update(GPUBackend* gpu, u32 frame_number, u32 internal_frame_number);
 void AccumulateGPUTime();
 
+/// Rewind/runahead save time on the CPU thread, and time moved to worker threads. Thread-safe.
+void AccumulateMemorySaveStateTime(double ms);
+void AccumulateAsyncMemorySaveStateTime(double ms);
+
+/// Time spent on and bytes written/read for a single component of a rewind/runahead state. Thread-safe.
+void AccumulateMemorySaveStateComponent(MemorySaveStateComponent component, bool is_load, u64 ticks, size_t size);
+
 } // namespace PerformanceCounters
@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "save_state_index.h"
+#include "settings.h"
+#include "system.h"
+
+#include "common/binary_reader_writer.h"
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/path.h"
+
+#include "fmt/format.h"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+LOG_CHANNEL(System);
+
+namespace SaveStateIndex {
+
+namespace {
+
+struct Entry
+{
+  std::string path;
+  s64 modification_time;
+  s64 file_size;
+  ExtendedSaveStateInfo info;
+};
+
+struct Index
+{
+  std::vector<Entry> entries;
+  bool dirty = false;
+};
+
+} // namespace
+
+static constexpr const char INDEX_SIGNATURE[] = {'S', 'S', 'I', 'D', 'X', '0', '0', '1'};
+static constexpr const char* INDEX_DIRECTORY_NAME = "savestates";
+
+static std::string GetIndexKey(std::string_view path);
+static std::string GetIndexPath(std::string_view key);
+static Index& GetIndex(const std::string& key);
+static bool ReadIndex(const std::string& key, Index* index, Error* error);
+static bool WriteIndex(const std::string& key, const Index& index, Error* error);
+
+static std::mutex s_mutex;
+static std::unordered_map<std::string, Index> s_indices;
+
+} // namespace SaveStateIndex
+
+std::string SaveStateIndex::GetIndexKey(std::string_view path)
+{
+  // Only states in the save state directory are indexed, anything else is an explicit file.
+  if (EmuFolders::Cache.empty() || EmuFolders::SaveStates.empty() ||
+      Path::GetDirectory(path) != EmuFolders::SaveStates)
+  {
+    return {};
+  }
+
+  // SERIAL_slot.sav/SERIAL_resume.sav/savestate_slot.sav, group by the prefix.
+  const std::string_view title = Path::GetFileTitle(path);
+  const std::string_view::size_type pos = title.rfind('_');
+  return Path::SanitizeFileName((pos != std::string_view::npos && pos > 0) ? title.substr(0, pos) : title);
+}
+
+std::string SaveStateIndex::GetIndexPath(std::string_view key)
+{
+  return Path::Combine(EmuFolders::Cache, fmt::format("{}" FS_OSPATH_SEPARATOR_STR "{}.idx", INDEX_DIRECTORY_NAME, key));
+}
+
+SaveStateIndex::Index& SaveStateIndex::GetIndex(const std::string& key)
+{
+  auto it = s_indices.find(key);
+  if (it != s_indices.end())
+    return it->second;
+
+  Index& index = s_indices.emplace(key, Index()).first->second;
+
+  Error error;
+  if (!ReadIndex(key, &index, &error))
+  {
+    WARNING_LOG("Failed to read save state index for '{}': {}", key, error.GetDescription());
+    index.entries.clear();
+  }
+
+  return index;
+}
+
+bool SaveStateIndex::ReadIndex(const std::string& key, Index* index, Error* error)
+{
+  const std::string path = GetIndexPath(key);
+  if (!FileSystem::FileExists(path.c_str()))
+    return true;
+
+  // one read for the whole index, the screenshots are stored decoded
+  const std::optional<DynamicHeapArray<u8>> data = FileSystem::ReadBinaryFile(path.c_str(), error);
+  if (!data.has_value())
+    return false;
+
+  BinarySpanReader reader(data->cspan());
+  char signature[sizeof(INDEX_SIGNATURE)];
+  u32 count;
+  if (!reader.Read(signature, sizeof(signature)) || std::memcmp(signature, INDEX_SIGNATURE, sizeof(signature)) != 0 ||
+      !reader.ReadU32(&count))
+  {
+    Error::SetStringView(error, "Invalid signature.");
+    return false;
+  }
+
+  index->entries.reserve(count);
+  for (u32 i = 0; i < count; i++)
+  {
+    Entry& entry = index->entries.emplace_back();
+    u32 screenshot_width, screenshot_height;
+    if (!reader.ReadSizePrefixedString(&entry.path) || !reader.ReadS64(&entry.modification_time) ||
+        !reader.ReadS64(&entry.file_size) || !reader.ReadSizePrefixedString(&entry.info.title) ||
+        !reader.ReadSizePrefixedString(&entry.info.serial) || !reader.ReadSizePrefixedString(&entry.info.media_path) ||
+        !reader.ReadU32(&screenshot_width) || !reader.ReadU32(&screenshot_height) || screenshot_width >= 32768 ||
+        screenshot_height >= 32768)
+    {
+      Error::SetStringView(error, "Index is truncated.");
+      return false;
+    }
+
+    entry.info.timestamp = static_cast<std::time_t>(entry.modification_time);
+    if (screenshot_width > 0 && screenshot_height > 0)
+    {
+      entry.info.screenshot.Resize(screenshot_width, screenshot_height, ImageFormat::RGBA8, false);
+      const std::span<u8> pixels = entry.info.screenshot.GetPixelsSpan();
+      if (!reader.Read(pixels.data(), pixels.size()))
+      {
+        Error::SetStringView(error, "Index is truncated.");
+        return false;
+      }
+    }
+  }
+
+  DEV_LOG("Read {} entries from save state index for '{}'", count, key);
+  return true;
+}
+
+bool SaveStateIndex::WriteIndex(const std::string& key, const Index& index, Error* error)
+{
+  std::string path = GetIndexPath(key);
+  if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(path)).c_str(), false, error))
+    return false;
+
+  auto fp = FileSystem::CreateAtomicRenamedFile(std::move(path), error);
+  if (!fp)
+    return false;
+
+  BinaryFileWriter writer(fp.get());
+  writer.Write(INDEX_SIGNATURE, sizeof(INDEX_SIGNATURE));
+  writer.WriteU32(static_cast<u32>(index.entries.size()));
+  for (const Entry& entry : index.entries)
+  {
+    const bool has_screenshot = entry.info.screenshot.IsValid();
+    writer.WriteSizePrefixedString(entry.path);
+    writer.WriteS64(entry.modification_time);
+    writer.WriteS64(entry.file_size);
+    writer.WriteSizePrefixedString(entry.info.title);
+    writer.WriteSizePrefixedString(entry.info.serial);
+    writer.WriteSizePrefixedString(entry.info.media_path);
+    writer.WriteU32(has_screenshot ? entry.info.screenshot.GetWidth() : 0);
+    writer.WriteU32(has_screenshot ? entry.info.screenshot.GetHeight() : 0);
+    if (has_screenshot)
+    {
+      const std::span<const u8> pixels = entry.info.screenshot.GetPixelsSpan();
+      writer.Write(pixels.data(), pixels.size());
+    }
+  }
+
+  if (!writer.Flush(error))
+  {
+    FileSystem::DiscardAtomicRenamedFile(fp);
+    return false;
+  }
+
+  return FileSystem::CommitAtomicRenamedFile(fp, error);
+}
+
+std::optional<ExtendedSaveStateInfo> SaveStateIndex::Lookup(std::string_view path, const FILESYSTEM_STAT_DATA& sd)
+{
+  std::optional<ExtendedSaveStateInfo> ret;
+
+  const std::string key = GetIndexKey(path);
+  if (key.empty())
+    return ret;
+
+  const std::unique_lock lock(s_mutex);
+  const Index& index = GetIndex(key);
+  for (const Entry& entry : index.entries)
+  {
+    if (entry.path != path)
+      continue;
+
+    if (entry.modification_time == static_cast<s64>(sd.ModificationTime) && entry.file_size == sd.Size)
+      ret = entry.info;
+
+    break;
+  }
+
+  return ret;
+}
+
+void SaveStateIndex::Update(std::string_view path, const FILESYSTEM_STAT_DATA& sd, const ExtendedSaveStateInfo& ssi)
+{
+  const std::string key = GetIndexKey(path);
+  if (key.empty())
+    return;
+
+  const std::unique_lock lock(s_mutex);
+  Index& index = GetIndex(key);
+  std::erase_if(index.entries, [&path](const Entry& entry) { return (entry.path == path); });
+
+  Entry& entry = index.entries.emplace_back();
+  entry.path = path;
+  entry.modification_time = static_cast<s64>(sd.ModificationTime);
+  entry.file_size = sd.Size;
+  entry.info = ssi;
+  entry.info.timestamp = sd.ModificationTime;
+  index.dirty = true;
+}
+
+void SaveStateIndex::Flush()
+{
+  const std::unique_lock lock(s_mutex);
+  for (auto& [key, index] : s_indices)
+  {
+    if (!index.dirty)
+      continue;
+
+    // drop entries for states which have since been deleted
+    std::erase_if(index.entries, [](const Entry& entry) { return !FileSystem::FileExists(entry.path.c_str()); });
+    index.dirty = false;
+
+    Error error;
+    if (!WriteIndex(key, index, &error))
+      ERROR_LOG("Failed to write save state index for '{}': {}", key, error.GetDescription());
+  }
+}
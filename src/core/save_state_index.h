@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "types.h"
+
+#include <optional>
+#include <string_view>
+
+struct ExtendedSaveStateInfo;
+struct FILESYSTEM_STAT_DATA;
+
+//////////////////////////////////////////////////////////////////////////
+// Cache of save state headers and decoded screenshots, so the state lists don't have to open and decompress every
+// state whenever they're shown. One index is kept per serial in the cache directory, and entries are only used if the
+// state file's modification time and size match what was indexed.
+//////////////////////////////////////////////////////////////////////////
+
+namespace SaveStateIndex {
+
+/// Returns the indexed information for the state at the specified path, if it has not changed since it was indexed.
+std::optional<ExtendedSaveStateInfo> Lookup(std::string_view path, const FILESYSTEM_STAT_DATA& sd);
+
+/// Records the information for the state at the specified path, replacing any existing entry. The index isn't written
+/// until Flush() is called, so listing many states only writes it once.
+void Update(std::string_view path, const FILESYSTEM_STAT_DATA& sd, const ExtendedSaveStateInfo& ssi);
+
+/// Writes any indices which have been updated since they were last written.
+void Flush();
+
+} // namespace SaveStateIndex
@@ -0,0 +1,365 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "save_state_store.h"
+#include "save_state_version.h"
+#include "settings.h"
+
+#include "util/compress_helpers.h"
+
+#include "common/bitutils.h"
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/heap_array.h"
+#include "common/log.h"
+#include "common/path.h"
+#include "common/timer.h"
+
+#include "fmt/format.h"
+#include "xxhash.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <unordered_set>
+
+LOG_CHANNEL(System);
+
+namespace SaveStateStore {
+
+namespace {
+
+#pragma pack(push, 4)
+struct ChunkEntry
+{
+  u64 hash_low;
+  u64 hash_high;
+  u32 size;
+};
+#pragma pack(pop)
+static_assert(sizeof(ChunkEntry) == 20);
+
+} // namespace
+
+static constexpr const char* CHUNK_DIRECTORY_NAME = "chunks";
+
+// Boundaries are content-defined, so inserting or removing bytes only changes the chunks around the edit.
+static constexpr size_t MIN_CHUNK_SIZE = 16 * 1024;
+static constexpr size_t MAX_CHUNK_SIZE = 256 * 1024;
+static constexpr u64 CHUNK_BOUNDARY_MASK = 0xFFFF000000000000ULL; // ~64KB past the minimum on average
+
+static constexpr u32 WRITES_PER_GARBAGE_COLLECTION = 32;
+
+static constexpr std::array<u64, 256> GenerateGearTable()
+{
+  // splitmix64, the table just has to be fixed and well-distributed
+  std::array<u64, 256> table = {};
+  u64 state = 0x44554353544F5245ULL;
+  for (u64& value : table)
+  {
+    state += 0x9E3779B97F4A7C15ULL;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    value = z ^ (z >> 31);
+  }
+  return table;
+}
+
+static constexpr std::array<u64, 256> s_gear_table = GenerateGearTable();
+
+static std::mutex s_store_mutex;
+static std::atomic<u32> s_writes_since_garbage_collection{0};
+
+static std::string GetChunkDirectory();
+static std::string GetChunkFileName(const ChunkEntry& entry);
+static std::string GetChunkPath(const std::string& chunk_dir, const ChunkEntry& entry);
+static size_t FindChunkBoundary(std::span<const u8> data);
+static int GetChunkCompressionLevel(SaveStateCompressionMode compression);
+static bool WriteChunk(const std::string& chunk_dir, const ChunkEntry& entry, std::span<const u8> data, int clevel,
+                       u32* bytes_written, Error* error);
+static bool ReadChunkList(const char* path, std::vector<ChunkEntry>* entries, Error* error);
+
+} // namespace SaveStateStore
+
+std::string SaveStateStore::GetChunkDirectory()
+{
+  return Path::Combine(EmuFolders::SaveStates, CHUNK_DIRECTORY_NAME);
+}
+
+std::string SaveStateStore::GetChunkFileName(const ChunkEntry& entry)
+{
+  return fmt::format("{:016x}{:016x}", entry.hash_high, entry.hash_low);
+}
+
+std::string SaveStateStore::GetChunkPath(const std::string& chunk_dir, const ChunkEntry& entry)
+{
+  // fan out by the first byte of the hash, keeps directory sizes sane
+  const std::string name = GetChunkFileName(entry);
+  return Path::Combine(Path::Combine(chunk_dir, std::string_view(name).substr(0, 2)), name);
+}
+
+bool SaveStateStore::IsStorePath(std::string_view path)
+{
+  return (!EmuFolders::SaveStates.empty() && Path::GetDirectory(path) == EmuFolders::SaveStates);
+}
+
+std::unique_lock<std::mutex> SaveStateStore::GetLock()
+{
+  return std::unique_lock<std::mutex>(s_store_mutex);
+}
+
+size_t SaveStateStore::FindChunkBoundary(std::span<const u8> data)
+{
+  if (data.size() <= MIN_CHUNK_SIZE)
+    return data.size();
+
+  // gear hash, the high bits depend on the last 64 bytes
+  const size_t end = std::min(data.size(), MAX_CHUNK_SIZE);
+  u64 hash = 0;
+  for (size_t i = MIN_CHUNK_SIZE; i < end; i++)
+  {
+    hash = (hash << 1) + s_gear_table[data[i]];
+    if ((hash & CHUNK_BOUNDARY_MASK) == 0)
+      return i + 1;
+  }
+
+  return end;
+}
+
+int SaveStateStore::GetChunkCompressionLevel(SaveStateCompressionMode compression)
+{
+  // Chunks are always zstd, the selected mode only picks the effort.
+  switch (compression)
+  {
+    case SaveStateCompressionMode::Uncompressed:
+    case SaveStateCompressionMode::DeflateLow:
+    case SaveStateCompressionMode::ZstLow:
+    case SaveStateCompressionMode::XZLow:
+      return 1;
+
+    case SaveStateCompressionMode::DeflateHigh:
+    case SaveStateCompressionMode::ZstHigh:
+    case SaveStateCompressionMode::XZHigh:
+      return 18;
+
+    default:
+      return 0;
+  }
+}
+
+bool SaveStateStore::WriteChunk(const std::string& chunk_dir, const ChunkEntry& entry, std::span<const u8> data,
+                                int clevel, u32* bytes_written, Error* error)
+{
+  std::string path = GetChunkPath(chunk_dir, entry);
+  if (FileSystem::FileExists(path.c_str()))
+    return true;
+
+  if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(path)).c_str(), true, error))
+    return false;
+
+  const CompressHelpers::OptionalByteBuffer compressed =
+    CompressHelpers::CompressToBuffer(CompressHelpers::CompressType::Zstandard, data, clevel, 0, error);
+  if (!compressed.has_value() || !FileSystem::WriteAtomicRenamedFile(std::move(path), compressed->cspan(), error))
+    return false;
+
+  *bytes_written += static_cast<u32>(compressed->size());
+  return true;
+}
+
+u32 SaveStateStore::WriteStateData(std::FILE* fp, std::span<const u8> data, SaveStateCompressionMode compression,
+                                   Error* error)
+{
+  Timer timer;
+
+  const std::string chunk_dir = GetChunkDirectory();
+  const int clevel = GetChunkCompressionLevel(compression);
+
+  std::vector<ChunkEntry> entries;
+  entries.reserve(data.size() / MIN_CHUNK_SIZE + 1);
+
+  u32 new_chunks = 0;
+  u32 new_bytes = 0;
+  for (size_t pos = 0; pos < data.size();)
+  {
+    const std::span<const u8> chunk = data.subspan(pos, FindChunkBoundary(data.subspan(pos)));
+    const XXH128_hash_t hash = XXH3_128bits(chunk.data(), chunk.size());
+    const ChunkEntry& entry =
+      entries.emplace_back(ChunkEntry{hash.low64, hash.high64, static_cast<u32>(chunk.size())});
+
+    const u32 prev_bytes = new_bytes;
+    if (!WriteChunk(chunk_dir, entry, chunk, clevel, &new_bytes, error))
+    {
+      Error::AddPrefixFmt(error, "Failed to write chunk {}: ", GetChunkFileName(entry));
+      return 0;
+    }
+
+    new_chunks += BoolToUInt32(new_bytes != prev_bytes);
+    pos += chunk.size();
+  }
+
+  const u32 list_size = static_cast<u32>(entries.size() * sizeof(ChunkEntry));
+  if (std::fwrite(entries.data(), list_size, 1, fp) != 1)
+  {
+    Error::SetErrno(error, "fwrite() for chunk list failed: ", errno);
+    return 0;
+  }
+
+  s_writes_since_garbage_collection.fetch_add(1, std::memory_order_acq_rel);
+
+  INFO_LOG("Stored {} bytes as {} chunks, {} new ({} bytes) in {:.2f} msec", data.size(), entries.size(), new_chunks,
+           new_bytes, timer.GetTimeMilliseconds());
+  return list_size;
+}
+
+bool SaveStateStore::ReadStateData(std::span<u8> dst, std::span<const u8> chunk_list, Error* error)
+{
+  if ((chunk_list.size() % sizeof(ChunkEntry)) != 0)
+  {
+    Error::SetStringView(error, "Chunk list is corrupted.");
+    return false;
+  }
+
+  const std::string chunk_dir = GetChunkDirectory();
+  const size_t num_entries = chunk_list.size() / sizeof(ChunkEntry);
+  size_t pos = 0;
+  for (size_t i = 0; i < num_entries; i++)
+  {
+    ChunkEntry entry;
+    std::memcpy(&entry, chunk_list.data() + i * sizeof(ChunkEntry), sizeof(entry));
+    if (entry.size > (dst.size() - pos))
+    {
+      Error::SetStringView(error, "Chunk list does not match state size.");
+      return false;
+    }
+
+    const std::string path = GetChunkPath(chunk_dir, entry);
+    const std::span<u8> chunk_dst = dst.subspan(pos, entry.size);
+    std::optional<DynamicHeapArray<u8>> compressed = FileSystem::ReadBinaryFile(path.c_str(), error);
+    if (!compressed.has_value() ||
+        CompressHelpers::DecompressBuffer(chunk_dst, CompressHelpers::CompressType::Zstandard, compressed->cspan(),
+                                          entry.size, error) != entry.size)
+    {
+      Error::AddPrefixFmt(error, "Failed to read chunk {}: ", GetChunkFileName(entry));
+      return false;
+    }
+
+    const XXH128_hash_t hash = XXH3_128bits(chunk_dst.data(), chunk_dst.size());
+    if (hash.low64 != entry.hash_low || hash.high64 != entry.hash_high)
+    {
+      Error::SetStringFmt(error, "Chunk {} is corrupted.", GetChunkFileName(entry));
+      return false;
+    }
+
+    pos += entry.size;
+  }
+
+  if (pos != dst.size())
+  {
+    Error::SetStringView(error, "Chunk list does not match state size.");
+    return false;
+  }
+
+  return true;
+}
+
+bool SaveStateStore::ShouldCollectGarbage()
+{
+  return (s_writes_since_garbage_collection.load(std::memory_order_acquire) >= WRITES_PER_GARBAGE_COLLECTION);
+}
+
+bool SaveStateStore::ReadChunkList(const char* path, std::vector<ChunkEntry>* entries, Error* error)
+{
+  entries->clear();
+
+  auto fp = FileSystem::OpenManagedSharedCFile(path, "rb", FileSystem::FileShareMode::DenyWrite, error);
+  if (!fp)
+    return false;
+
+  // Files which aren't states or don't use the store have no references.
+  SAVE_STATE_HEADER header;
+  if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.magic != SAVE_STATE_MAGIC ||
+      header.data_compression_type != static_cast<u32>(SAVE_STATE_HEADER::CompressionType::ChunkStore))
+  {
+    return true;
+  }
+
+  if ((header.data_compressed_size % sizeof(ChunkEntry)) != 0)
+  {
+    Error::SetStringView(error, "Chunk list is corrupted.");
+    return false;
+  }
+
+  entries->resize(header.data_compressed_size / sizeof(ChunkEntry));
+  if (!FileSystem::FSeek64(fp.get(), header.offset_to_data, SEEK_SET, error))
+    return false;
+
+  if (!entries->empty() && std::fread(entries->data(), header.data_compressed_size, 1, fp.get()) != 1)
+  {
+    Error::SetErrno(error, "fread() for chunk list failed: ", errno);
+    return false;
+  }
+
+  return true;
+}
+
+void SaveStateStore::CollectGarbage()
+{
+  const std::string chunk_dir = GetChunkDirectory();
+  if (!FileSystem::DirectoryExists(chunk_dir.c_str()))
+    return;
+
+  const auto lock = GetLock();
+  s_writes_since_garbage_collection.store(0, std::memory_order_release);
+
+  Timer timer;
+
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(EmuFolders::SaveStates.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES,
+                        &files);
+
+  std::unordered_set<std::string> referenced;
+  std::vector<ChunkEntry> entries;
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+  {
+    const std::string_view extension = Path::GetExtension(fd.FileName);
+    if (extension != "sav" && extension != "bak")
+      continue;
+
+    // If a state can't be read, we can't tell which chunks it uses, so don't remove anything.
+    Error error;
+    if (!ReadChunkList(fd.FileName.c_str(), &entries, &error))
+    {
+      WARNING_LOG("Skipping garbage collection, failed to read '{}': {}", Path::GetFileName(fd.FileName),
+                  error.GetDescription());
+      return;
+    }
+
+    for (const ChunkEntry& entry : entries)
+      referenced.insert(GetChunkFileName(entry));
+  }
+
+  files.clear();
+  FileSystem::FindFiles(chunk_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE, &files);
+
+  u32 removed_chunks = 0;
+  u64 removed_bytes = 0;
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+  {
+    if (referenced.contains(std::string(Path::GetFileName(fd.FileName))))
+      continue;
+
+    Error error;
+    if (!FileSystem::DeleteFile(fd.FileName.c_str(), &error))
+    {
+      ERROR_LOG("Failed to remove chunk '{}': {}", Path::GetFileName(fd.FileName), error.GetDescription());
+      continue;
+    }
+
+    removed_chunks++;
+    removed_bytes += static_cast<u64>(fd.Size);
+  }
+
+  INFO_LOG("Removed {} unreferenced chunks ({} bytes), {} in use, in {:.2f} msec", removed_chunks, removed_bytes,
+           referenced.size(), timer.GetTimeMilliseconds());
+}
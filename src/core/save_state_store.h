@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "types.h"
+
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string_view>
+
+class Error;
+
+//////////////////////////////////////////////////////////////////////////
+// Content-addressed chunk store for save state data.
+// States saved into the save state directory are split into variable-sized chunks, which are stored once in the
+// chunks subdirectory and shared between all slots/games. The .sav file keeps its header, media path and screenshot
+// inline, with the data section replaced by a list of chunk references.
+//////////////////////////////////////////////////////////////////////////
+
+namespace SaveStateStore {
+
+/// Returns true if the state file at the specified path can reference the store.
+bool IsStorePath(std::string_view path);
+
+/// Must be held while writing a state which references the store, until the file is committed. Prevents garbage
+/// collection from removing chunks which are only referenced by a state which is still being written.
+std::unique_lock<std::mutex> GetLock();
+
+/// Writes any chunks of the state data which are not already present to the store, and the chunk list to fp.
+/// Returns the size of the chunk list, or zero on failure.
+u32 WriteStateData(std::FILE* fp, std::span<const u8> data, SaveStateCompressionMode compression, Error* error);
+
+/// Reassembles state data from the chunk list previously written by WriteStateData().
+bool ReadStateData(std::span<u8> dst, std::span<const u8> chunk_list, Error* error);
+
+/// Returns true if enough states have been written since the last collection to warrant another.
+bool ShouldCollectGarbage();
+
+/// Removes chunks which are no longer referenced by any state or backup in the save state directory.
+void CollectGarbage();
+
+} // namespace SaveStateStore
@@ -27,6 +27,9 @@ struct SAVE_STATE_HEADER
     Deflate = 1,
     Zstandard = 2,
     XZ = 3,
+
+    // Data section is a list of chunks held in the save state store, see save_state_store.h.
+    ChunkStore = 4,
   };
 
   u32 magic;
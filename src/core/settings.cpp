@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cctype>
 #include <numeric>
 
@@ -208,6 +209,7 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   create_save_state_backups = si.GetBoolValue("Main", "CreateSaveStateBackups", DEFAULT_SAVE_STATE_BACKUPS);
   confim_power_off = si.GetBoolValue("Main", "ConfirmPowerOff", true);
   load_devices_from_save_states = si.GetBoolValue("Main", "LoadDevicesFromSaveStates", false);
+  save_state_deduplication = si.GetBoolValue("Main", "SaveStateDeduplication", false);
   apply_compatibility_settings = si.GetBoolValue("Main", "ApplyCompatibilitySettings", true);
   apply_game_settings = si.GetBoolValue("Main", "ApplyGameSettings", true);
   disable_all_enhancements = si.GetBoolValue("Main", "DisableAllEnhancements", false);
@@ -215,8 +217,16 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   rewind_enable = si.GetBoolValue("Main", "RewindEnable", false);
   rewind_save_frequency = si.GetFloatValue("Main", "RewindFrequency", 10.0f);
   rewind_save_slots = static_cast<u16>(std::min(si.GetUIntValue("Main", "RewindSaveSlots", 10u), 65535u));
+  rewind_compression = si.GetBoolValue("Main", "RewindCompression", false);
+  memory_save_state_snapshot_mode =
+    ParseMemorySaveStateSnapshotModeName(
+      si.GetStringValue("Main", "MemorySaveStateSnapshot",
+                        GetMemorySaveStateSnapshotModeName(DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE))
+        .c_str())
+      .value_or(DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE);
   runahead_frames = static_cast<u8>(std::min(si.GetUIntValue("Main", "RunaheadFrameCount", 0u), 255u));
   runahead_for_analog_input = si.GetBoolValue("Main", "RunaheadForAnalogInput", false);
+  runahead_headless_replay = si.GetBoolValue("Main", "RunaheadHeadlessReplay", false);
 
   cpu_execution_mode =
     ParseCPUExecutionMode(
@@ -229,6 +239,10 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   cpu_recompiler_memory_exceptions = si.GetBoolValue("CPU", "RecompilerMemoryExceptions", false);
   cpu_recompiler_block_linking = si.GetBoolValue("CPU", "RecompilerBlockLinking", true);
   cpu_recompiler_icache = si.GetBoolValue("CPU", "RecompilerICache", false);
+  cpu_recompiler_block_cache = si.GetBoolValue("CPU", "RecompilerBlockCache", false);
+  cpu_recompiler_traces = si.GetBoolValue("CPU", "RecompilerTraces", false);
+  cpu_recompiler_block_profiling = si.GetBoolValue("CPU", "RecompilerBlockProfiling", false);
+  cpu_recompiler_idle_loop_skipping = si.GetBoolValue("CPU", "RecompilerIdleLoopSkipping", false);
   cpu_fastmem_mode = ParseCPUFastmemMode(
                        si.GetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(DEFAULT_CPU_FASTMEM_MODE)).c_str())
                        .value_or(DEFAULT_CPU_FASTMEM_MODE);
@@ -255,6 +269,13 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
   gpu_max_queued_frames = static_cast<u8>(si.GetUIntValue("GPU", "MaxQueuedFrames", DEFAULT_GPU_MAX_QUEUED_FRAMES));
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
+  gpu_software_renderer_threads = static_cast<u8>(si.GetUIntValue("GPU", "SoftwareRendererThreads", 0u));
+  // only 1x, 2x and 4x are supported
+  const u32 software_renderer_scale = si.GetUIntValue("GPU", "SoftwareRendererScale", 1u);
+  gpu_software_renderer_scale =
+    static_cast<u8>((software_renderer_scale <= 4 && std::has_single_bit(software_renderer_scale)) ?
+                      software_renderer_scale :
+                      1u);
   gpu_scaled_interlacing = si.GetBoolValue("GPU", "ScaledInterlacing", true);
   gpu_force_round_texcoords = si.GetBoolValue("GPU", "ForceRoundTextureCoordinates", false);
   gpu_texture_filter =
@@ -594,12 +615,17 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   }
 
   si.SetBoolValue("Main", "LoadDevicesFromSaveStates", load_devices_from_save_states);
+  si.SetBoolValue("Main", "SaveStateDeduplication", save_state_deduplication);
   si.SetBoolValue("Main", "DisableAllEnhancements", disable_all_enhancements);
   si.SetBoolValue("Main", "RewindEnable", rewind_enable);
   si.SetFloatValue("Main", "RewindFrequency", rewind_save_frequency);
   si.SetUIntValue("Main", "RewindSaveSlots", rewind_save_slots);
+  si.SetBoolValue("Main", "RewindCompression", rewind_compression);
+  si.SetStringValue("Main", "MemorySaveStateSnapshot",
+                    GetMemorySaveStateSnapshotModeName(memory_save_state_snapshot_mode));
   si.SetUIntValue("Main", "RunaheadFrameCount", runahead_frames);
   si.SetBoolValue("Main", "RunaheadForAnalogInput", runahead_for_analog_input);
+  si.SetBoolValue("Main", "RunaheadHeadlessReplay", runahead_headless_replay);
 
   si.SetStringValue("CPU", "ExecutionMode", GetCPUExecutionModeName(cpu_execution_mode));
   si.SetBoolValue("CPU", "OverclockEnable", cpu_overclock_enable);
@@ -608,6 +634,10 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("CPU", "RecompilerMemoryExceptions", cpu_recompiler_memory_exceptions);
   si.SetBoolValue("CPU", "RecompilerBlockLinking", cpu_recompiler_block_linking);
   si.SetBoolValue("CPU", "RecompilerICache", cpu_recompiler_icache);
+  si.SetBoolValue("CPU", "RecompilerBlockCache", cpu_recompiler_block_cache);
+  si.SetBoolValue("CPU", "RecompilerTraces", cpu_recompiler_traces);
+  si.SetBoolValue("CPU", "RecompilerBlockProfiling", cpu_recompiler_block_profiling);
+  si.SetBoolValue("CPU", "RecompilerIdleLoopSkipping", cpu_recompiler_idle_loop_skipping);
   si.SetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(cpu_fastmem_mode));
 
   si.SetStringValue("GPU", "Renderer", GetRendererName(gpu_renderer));
@@ -635,6 +665,8 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetUIntValue("GPU", "MaxQueuedFrames", gpu_max_queued_frames);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
   si.SetBoolValue("GPU", "UseSoftwareRendererForReadbacks", gpu_use_software_renderer_for_readbacks);
+  si.SetUIntValue("GPU", "SoftwareRendererThreads", gpu_software_renderer_threads);
+  si.SetUIntValue("GPU", "SoftwareRendererScale", gpu_software_renderer_scale);
   si.SetBoolValue("GPU", "ScaledInterlacing", gpu_scaled_interlacing);
   si.SetBoolValue("GPU", "ForceRoundTextureCoordinates", gpu_force_round_texcoords);
   si.SetStringValue("GPU", "TextureFilter", GetTextureFilterName(gpu_texture_filter));
@@ -1064,6 +1096,7 @@ void Settings::ApplySettingRestrictions()
     g_settings.bios_patch_fast_boot = false;
     g_settings.runahead_frames = 0;
     g_settings.runahead_for_analog_input = false;
+    g_settings.runahead_headless_replay = false;
     g_settings.rewind_enable = false;
     g_settings.pio_device_type = PIODeviceType::None;
     g_settings.pcdrv_enable = false;
@@ -2456,6 +2489,47 @@ const char* Settings::GetSaveStateCompressionModeDisplayName(SaveStateCompressio
                                   "SaveStateCompressionMode");
 }
 
+static constexpr const std::array s_memory_save_state_snapshot_mode_names = {
+  "Full",
+  "WriteTracking",
+  "SoftDirty",
+};
+static constexpr const std::array s_memory_save_state_snapshot_mode_display_names = {
+  TRANSLATE_DISAMBIG_NOOP("Settings", "Full Copy", "MemorySaveStateSnapshotMode"),
+  TRANSLATE_DISAMBIG_NOOP("Settings", "Write Tracking", "MemorySaveStateSnapshotMode"),
+  TRANSLATE_DISAMBIG_NOOP("Settings", "Kernel Soft-Dirty Bits (Linux Only)", "MemorySaveStateSnapshotMode"),
+};
+static_assert(s_memory_save_state_snapshot_mode_names.size() ==
+              static_cast<size_t>(MemorySaveStateSnapshotMode::Count));
+static_assert(s_memory_save_state_snapshot_mode_display_names.size() ==
+              static_cast<size_t>(MemorySaveStateSnapshotMode::Count));
+
+std::optional<MemorySaveStateSnapshotMode> Settings::ParseMemorySaveStateSnapshotModeName(const char* str)
+{
+  u32 index = 0;
+  for (const char* name : s_memory_save_state_snapshot_mode_names)
+  {
+    if (StringUtil::Strcasecmp(name, str) == 0)
+      return static_cast<MemorySaveStateSnapshotMode>(index);
+
+    index++;
+  }
+
+  return std::nullopt;
+}
+
+const char* Settings::GetMemorySaveStateSnapshotModeName(MemorySaveStateSnapshotMode mode)
+{
+  return s_memory_save_state_snapshot_mode_names[static_cast<size_t>(mode)];
+}
+
+const char* Settings::GetMemorySaveStateSnapshotModeDisplayName(MemorySaveStateSnapshotMode mode)
+{
+  return Host::TranslateToCString("Settings",
+                                  s_memory_save_state_snapshot_mode_display_names[static_cast<size_t>(mode)],
+                                  "MemorySaveStateSnapshotMode");
+}
+
 static constexpr const std::array s_pio_device_type_names = {
   "None",
   "XplorerCart",
@@ -95,6 +95,8 @@ struct GPUSettings
   s8 display_line_end_offset = 0;
 
   u8 gpu_max_queued_frames = DEFAULT_GPU_MAX_QUEUED_FRAMES;
+  u8 gpu_software_renderer_threads = 0;
+  u8 gpu_software_renderer_scale = 1;
   bool gpu_use_thread : 1 = true;
   bool gpu_use_software_renderer_for_readbacks : 1 = false;
   bool gpu_use_debug_device : 1 = false;
@@ -294,6 +296,10 @@ struct Settings : public GPUSettings
   bool cpu_recompiler_memory_exceptions : 1 = false;
   bool cpu_recompiler_block_linking : 1 = true;
   bool cpu_recompiler_icache : 1 = false;
+  bool cpu_recompiler_block_cache : 1 = false;
+  bool cpu_recompiler_traces : 1 = false;
+  bool cpu_recompiler_block_profiling : 1 = false;
+  bool cpu_recompiler_idle_loop_skipping : 1 = false;
   bool cpu_enable_8mb_ram : 1 = false;
 
   bool mdec_use_old_routines : 1 = false;
@@ -322,16 +328,20 @@ struct Settings : public GPUSettings
   bool bios_fast_forward_boot : 1 = false;
 
   bool rewind_enable : 1 = false;
+  bool rewind_compression : 1 = false;
   bool runahead_for_analog_input : 1 = false;
+  bool runahead_headless_replay : 1 = false;
 
   bool apply_compatibility_settings : 1 = true;
   bool apply_game_settings : 1 = true;
   bool load_devices_from_save_states : 1 = false;
+  bool save_state_deduplication : 1 = false;
 
   u8 runahead_frames = 0;
   u16 rewind_save_slots = 10;
 
   SaveStateCompressionMode save_state_compression = DEFAULT_SAVE_STATE_COMPRESSION_MODE;
+  MemorySaveStateSnapshotMode memory_save_state_snapshot_mode = DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE;
 
   u8 cdrom_readahead_sectors = DEFAULT_CDROM_READAHEAD_SECTORS;
   CDROMMechaconVersion cdrom_mechacon_version = DEFAULT_CDROM_MECHACON_VERSION;
@@ -590,6 +600,10 @@ struct Settings : public GPUSettings
   static const char* GetSaveStateCompressionModeName(SaveStateCompressionMode mode);
   static const char* GetSaveStateCompressionModeDisplayName(SaveStateCompressionMode mode);
 
+  static std::optional<MemorySaveStateSnapshotMode> ParseMemorySaveStateSnapshotModeName(const char* str);
+  static const char* GetMemorySaveStateSnapshotModeName(MemorySaveStateSnapshotMode mode);
+  static const char* GetMemorySaveStateSnapshotModeDisplayName(MemorySaveStateSnapshotMode mode);
+
   static std::optional<PIODeviceType> ParsePIODeviceTypeName(const char* str);
   static const char* GetPIODeviceTypeModeName(PIODeviceType type);
   static const char* GetPIODeviceTypeModeDisplayName(PIODeviceType type);
@@ -630,6 +644,8 @@ struct Settings : public GPUSettings
   static constexpr u8 DEFAULT_LEADERBOARD_NOTIFICATION_TIME = 10;
 
   static constexpr SaveStateCompressionMode DEFAULT_SAVE_STATE_COMPRESSION_MODE = SaveStateCompressionMode::ZstDefault;
+  static constexpr MemorySaveStateSnapshotMode DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE =
+    MemorySaveStateSnapshotMode::WriteTracking;
 
   static const MediaCaptureBackend DEFAULT_MEDIA_CAPTURE_BACKEND;
   static constexpr const char* DEFAULT_MEDIA_CAPTURE_CONTAINER = "mp4";
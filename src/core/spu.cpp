@@ -56,6 +56,8 @@ enum : u32
 {
   SPU_BASE = 0x1F801C00,
   NUM_VOICES = 24,
+  ALL_VOICES_MASK = (1u << NUM_VOICES) - 1,
+  CAPTURED_VOICES_MASK = (1u << 1) | (1u << 3),
   NUM_VOICE_REGISTERS = 8,
   VOICE_ADDRESS_SHIFT = 3,
   NUM_SAMPLES_PER_ADPCM_BLOCK = 28,
@@ -345,7 +347,7 @@ static void WriteToCaptureBuffer(u32 index, s16 value);
 static void IncrementCaptureBufferPosition();
 
 static void ReadADPCMBlock(u16 address, ADPCMBlock* block);
-static std::tuple<s32, s32> SampleVoice(u32 voice_index);
+static std::tuple<s32, s32> SampleVoice(u32 voice_index, bool output_needed);
 
 static void UpdateNoise();
 
@@ -425,6 +427,7 @@ struct SPUState
   s16 last_reverb_input[2];
   s32 last_reverb_output[2];
   bool audio_output_muted = false;
+  bool discard_voice_output = false;
 
 #ifdef SPU_DUMP_ALL_VOICES
   // +1 for reverb output
@@ -1675,6 +1678,11 @@ void SPU::SetAudioOutputMuted(bool muted)
   s_state.audio_output_muted = muted;
 }
 
+void SPU::SetDiscardVoiceOutput(bool discard)
+{
+  s_state.discard_voice_output = discard;
+}
+
 AudioStream* SPU::GetOutputStream()
 {
   return s_state.audio_stream.get();
@@ -2045,7 +2053,7 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
-ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index, bool output_needed)
 {
   Voice& voice = s_state.voices[voice_index];
   if (!voice.IsOn() && !s_state.SPUCNT.irq9_enable)
@@ -2077,9 +2085,9 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
     }
   }
 
-  // skip interpolation when the volume is muted anyway
+  // skip interpolation when the volume is muted anyway, or when nothing is going to hear the sample
   s32 volume;
-  if (voice.regs.adsr_volume != 0)
+  if (voice.regs.adsr_volume != 0 && output_needed)
   {
     // interpolate/sample and apply ADSR volume
     s32 sample;
@@ -2404,6 +2412,13 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
     s_state.ticks_carry = (ticks + s_state.ticks_carry) % SYSCLK_TICKS_PER_SPU_TICK;
   }
 
+  // When the output is being thrown away, only voices that feed reverb, the capture buffers, or pitch modulation of
+  // the next voice need to be interpolated. Register writes sync the SPU, so these can't change within a slice.
+  const u32 sampled_voices =
+    s_state.discard_voice_output ?
+      (s_state.reverb_on_register | (s_state.pitch_modulation_enable_register >> 1) | CAPTURED_VOICES_MASK) :
+      ALL_VOICES_MASK;
+
   while (remaining_frames > 0)
   {
     s16* output_frame_start;
@@ -2433,7 +2448,7 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
 
       for (u32 voice = 0; voice < NUM_VOICES; voice++)
       {
-        const auto [left, right] = SampleVoice(voice);
+        const auto [left, right] = SampleVoice(voice, ConvertToBoolUnchecked((sampled_voices >> voice) & 1u));
         left_sum += left;
         right_sum += right;
 
@@ -47,6 +47,9 @@ std::array<u8, RAM_SIZE>& GetWritableRAM();
 bool IsAudioOutputMuted();
 void SetAudioOutputMuted(bool muted);
 
+/// Skips interpolation of voices which are only audible in the output. Used for headless runahead replay.
+void SetDiscardVoiceOutput(bool discard);
+
 AudioStream* GetOutputStream();
 void RecreateOutputStream();
 
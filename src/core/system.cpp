@@ -33,6 +33,8 @@
 #include "performance_counters.h"
 #include "pio.h"
 #include "psf_loader.h"
+#include "save_state_index.h"
+#include "save_state_store.h"
 #include "save_state_version.h"
 #include "sio.h"
 #include "spu.h"
@@ -124,6 +126,10 @@ static constexpr u32 MAX_SKIPPED_DUPLICATE_FRAME_COUNT = 2; // 20fps minimum
 static constexpr u32 MAX_SKIPPED_TIMEOUT_FRAME_COUNT = 1;   // 30fps minimum
 static constexpr u8 MEMORY_CARD_FAST_FORWARD_FRAMES = 30;
 
+// Number of frames at the end of a runahead replay that are still rendered in headless mode. Two frames, because
+// double-buffered games display the image which was drawn during the previous frame.
+static constexpr u32 RUNAHEAD_HEADLESS_RENDERED_FRAMES = 2;
+
 namespace {
 
 struct SaveStateBuffer
@@ -217,11 +223,17 @@ static bool ReadAndDecompressStateData(std::FILE* fp, std::span<u8> dst, u32 fil
                                        SAVE_STATE_HEADER::CompressionType method, Error* error);
 static bool SaveStateToBuffer(SaveStateBuffer* buffer, Error* error, u32 screenshot_size = 256);
 static bool SaveStateBufferToFile(const SaveStateBuffer& buffer, std::FILE* fp, Error* error,
-                                  SaveStateCompressionMode compression_mode);
+                                  SaveStateCompressionMode compression_mode, bool use_store);
 static u32 CompressAndWriteStateData(std::FILE* fp, std::span<const u8> src, SaveStateCompressionMode method,
                                      u32* header_type, Error* error);
 static bool DoState(StateWrapper& sw, bool update_display);
 static void DoMemoryState(StateWrapper& sw, MemorySaveState& mss, bool update_display);
+static MemorySaveState& GetMemoryStateFromFront(u32 offset);
+static void XORMemoryStateData(u8* RESTRICT dst, const u8* RESTRICT src, size_t size);
+static void CompressMemoryStateDelta(MemorySaveState& mss, const MemorySaveState& next_mss);
+static bool DecompressMemoryStateDelta(MemorySaveState& mss, const MemorySaveState& next_mss);
+static void UpdateMemoryStateDeltaSize(const MemorySaveState& mss, bool add);
+static void WaitForMemoryStateCompression();
 
 static bool IsExecutionInterrupted();
 static void CheckForAndExitExecution();
@@ -230,6 +242,7 @@ static void SetRewinding(bool enabled);
 static void DoRewind();
 
 static bool DoRunahead();
+static void UpdateRunaheadHeadlessReplay();
 
 static bool ChangeGPUDump(std::string new_path);
 
@@ -303,6 +316,16 @@ struct ALIGN_TO_CACHE_LINE StateVars
   u32 memory_save_state_front = 0;
   u32 memory_save_state_count = 0;
 
+  // Rewind compression keeps one full-size buffer spare, which is swapped in/out as states are (de)compressed.
+  bool memory_save_state_compression = false;
+  DynamicHeapArray<u8> memory_save_state_spare_data;
+  u64 memory_save_state_delta_total_size = 0;
+  u32 memory_save_state_delta_count = 0;
+  std::atomic<u32> memory_save_state_average_delta_size{0};
+
+  // Deltas are compressed on a worker thread, keeping it off the frame time. Tasks must complete in order.
+  TaskQueue memory_save_state_task_queue;
+
   const BIOS::ImageInfo* bios_image_info = nullptr;
   BIOS::ImageInfo::Hash bios_hash = {};
   u32 taints = 0;
@@ -562,6 +585,7 @@ void System::CPUThreadShutdown()
   InputManager::CloseSources();
 
   s_state.async_task_queue.SetWorkerCount(0);
+  s_state.memory_save_state_task_queue.SetWorkerCount(0);
   s_state.cpu_thread_handle = {};
 
 #ifdef _WIN32
@@ -2600,6 +2624,9 @@ System::MemorySaveState& System::GetFirstMemoryState()
   const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
   DebugAssert(s_state.memory_save_state_count > 0);
 
+  // Older states can't be loaded directly when they're stored as deltas.
+  DebugAssert(!s_state.memory_save_state_compression || s_state.memory_save_state_count == 1);
+
   const s32 front =
     static_cast<s32>(s_state.memory_save_state_front) - static_cast<s32>(s_state.memory_save_state_count);
   const u32 idx = static_cast<u32>((front < 0) ? (front + static_cast<s32>(max_count)) : front);
@@ -2608,18 +2635,38 @@ System::MemorySaveState& System::GetFirstMemoryState()
 
 System::MemorySaveState& System::PopMemoryState()
 {
+  WaitForMemoryStateCompression();
+
   const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
   DebugAssert(s_state.memory_save_state_count > 0);
   s_state.memory_save_state_count--;
 
   const s32 front = static_cast<s32>(s_state.memory_save_state_front) - 1;
   s_state.memory_save_state_front = static_cast<u32>((front < 0) ? (front + static_cast<s32>(max_count)) : front);
-  return s_state.memory_save_states[s_state.memory_save_state_front];
+
+  // The popped state stays uncompressed, so reconstruct the one before it, which becomes the new newest state.
+  MemorySaveState& ret = s_state.memory_save_states[s_state.memory_save_state_front];
+  if (s_state.memory_save_state_compression && s_state.memory_save_state_count > 0 &&
+      !DecompressMemoryStateDelta(GetMemoryStateFromFront(1), ret))
+  {
+    ERROR_LOG("Failed to decompress rewind state, discarding {} older states.", s_state.memory_save_state_count);
+    s_state.memory_save_state_count = 0;
+  }
+
+  return ret;
+}
+
+System::MemorySaveState& System::GetMemoryStateFromFront(u32 offset)
+{
+  const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
+  DebugAssert(offset > 0 && offset <= max_count);
+  return s_state.memory_save_states[(s_state.memory_save_state_front + max_count - offset) % max_count];
 }
 
 bool System::AllocateMemoryStates(size_t state_count, bool recycle_old_textures)
 {
   DEV_LOG("Allocating {} memory save state slots", state_count);
+  WaitForMemoryStateCompression();
 
   if (state_count != s_state.memory_save_states.size())
   {
@@ -2627,16 +2674,29 @@ bool System::AllocateMemoryStates(size_t state_count, bool recycle_old_textures)
     s_state.memory_save_states.resize(state_count);
   }
 
-  // Allocate CPU buffers.
+  // Allocate CPU buffers. Compressed states are sized on demand, only the spare buffer is preallocated.
   // TODO: Maybe look at host memory limits here...
   const size_t size = GetMaxMemorySaveStateSize();
   for (MemorySaveState& mss : s_state.memory_save_states)
   {
     mss.state_size = 0;
-    if (mss.state_data.size() != size)
+    mss.state_is_delta = false;
+    mss.state_is_compressed = false;
+    mss.ram_generation = 0;
+    if (s_state.memory_save_state_compression)
+      mss.state_data.deallocate();
+    else if (mss.state_data.size() != size)
       mss.state_data.resize(size);
   }
 
+  if (s_state.memory_save_state_compression)
+    s_state.memory_save_state_spare_data.resize(size);
+  else
+    s_state.memory_save_state_spare_data.deallocate();
+
+  s_state.memory_save_state_delta_total_size = 0;
+  s_state.memory_save_state_delta_count = 0;
+
   // Allocate GPU buffers.
   Error error;
   if (!GPUBackend::AllocateMemorySaveStates(s_state.memory_save_states, &error))
@@ -2660,9 +2720,22 @@ bool System::AllocateMemoryStates(size_t state_count, bool recycle_old_textures)
 
 void System::ClearMemorySaveStates(bool reallocate_resources, bool recycle_textures)
 {
+  WaitForMemoryStateCompression();
   s_state.memory_save_state_front = 0;
   s_state.memory_save_state_count = 0;
 
+  // Deltas are meaningless without the newer states, buffers get recycled on the next save.
+  if (s_state.memory_save_state_compression)
+  {
+    for (MemorySaveState& mss : s_state.memory_save_states)
+    {
+      mss.state_is_delta = false;
+      mss.ram_generation = 0;
+    }
+    s_state.memory_save_state_delta_total_size = 0;
+    s_state.memory_save_state_delta_count = 0;
+  }
+
   if (reallocate_resources && !s_state.memory_save_states.empty())
   {
     if (!AllocateMemoryStates(s_state.memory_save_states.size(), recycle_textures))
@@ -2675,6 +2748,7 @@ void System::ClearMemorySaveStates(bool reallocate_resources, bool recycle_textu
 
 void System::FreeMemoryStateStorage(bool release_memory, bool release_textures, bool recycle_textures)
 {
+  WaitForMemoryStateCompression();
   if (release_memory || release_textures)
   {
     // TODO: use non-copyable function, that way we don't need to store raw pointers
@@ -2701,8 +2775,15 @@ void System::FreeMemoryStateStorage(bool release_memory, bool release_textures,
       mss.gpu_state_size = 0;
       mss.state_data.deallocate();
       mss.state_size = 0;
+      mss.state_is_delta = false;
+      mss.state_is_compressed = false;
+      mss.ram_generation = 0;
     }
 
+    s_state.memory_save_state_spare_data.deallocate();
+    s_state.memory_save_state_delta_total_size = 0;
+    s_state.memory_save_state_delta_count = 0;
+
     if (!textures.empty())
     {
       GPUThread::RunOnThread([textures = std::move(textures), recycle_textures]() mutable {
@@ -2731,6 +2812,7 @@ void System::LoadMemoryState(MemorySaveState& mss, bool update_display)
   Timer load_timer;
 #endif
 
+  DebugAssert(!mss.state_is_delta);
   StateWrapper sw(mss.state_data.cspan(0, mss.state_size), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
   DoMemoryState(sw, mss, update_display);
   DebugAssert(!sw.HasError());
@@ -2746,60 +2828,218 @@ void System::LoadMemoryState(MemorySaveState& mss, bool update_display)
 
 void System::SaveMemoryState(MemorySaveState& mss)
 {
-#ifdef PROFILE_MEMORY_SAVE_STATES
   Timer save_timer;
-#endif
+
+  if (s_state.memory_save_state_compression)
+  {
+    // Previous delta may still be using the spare buffer.
+    WaitForMemoryStateCompression();
+
+    // Slot may contain an evicted delta, the newest state always needs a full-size buffer.
+    DebugAssert(&mss == &GetMemoryStateFromFront(1));
+    if (mss.state_is_delta)
+      UpdateMemoryStateDeltaSize(mss, false);
+
+    const size_t size = GetMaxMemorySaveStateSize();
+    if (mss.state_data.size() != size)
+    {
+      mss.state_data.swap(s_state.memory_save_state_spare_data);
+      if (mss.state_data.size() != size)
+        mss.state_data.resize(size);
+    }
+
+    mss.state_is_delta = false;
+    mss.state_is_compressed = false;
+    mss.ram_generation = 0;
+  }
 
   StateWrapper sw(mss.state_data.span(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
   DoMemoryState(sw, mss, false);
   DebugAssert(!sw.HasError());
   mss.state_size = sw.GetPosition();
 
+  // Previous newest state can now be stored relative to this one. Neither is touched again until the task completes.
+  if (s_state.memory_save_state_compression && s_state.memory_save_state_count > 1)
+  {
+    s_state.memory_save_state_task_queue.SubmitTask([&mss = GetMemoryStateFromFront(2), &next_mss = mss]() {
+      Timer compress_timer;
+      CompressMemoryStateDelta(mss, next_mss);
+      PerformanceCounters::AccumulateAsyncMemorySaveStateTime(compress_timer.GetTimeMilliseconds());
+    });
+  }
+
+  const double save_time = save_timer.GetTimeMilliseconds();
+  PerformanceCounters::AccumulateMemorySaveStateTime(save_time);
+
 #ifdef PROFILE_MEMORY_SAVE_STATES
   DEV_LOG("Saving frame {} to memory state slot {} took {} bytes and {:.4f} ms", s_state.frame_number,
-          &mss - s_state.memory_save_states.data(), mss.state_size, save_timer.GetTimeMilliseconds());
+          &mss - s_state.memory_save_states.data(), mss.state_size, save_time);
 #else
   DEBUG_LOG("Saving frame {} to memory state slot {}", s_state.frame_number, &mss - s_state.memory_save_states.data());
 #endif
 }
 
+void System::WaitForMemoryStateCompression()
+{
+  s_state.memory_save_state_task_queue.WaitForAll();
+}
+
+void System::XORMemoryStateData(u8* RESTRICT dst, const u8* RESTRICT src, size_t size)
+{
+  // Unchanged regions become runs of zeros, which the compressor makes short work of.
+  size_t pos = 0;
+  for (; (pos + sizeof(u64)) <= size; pos += sizeof(u64))
+  {
+    u64 dv, sv;
+    std::memcpy(&dv, dst + pos, sizeof(dv));
+    std::memcpy(&sv, src + pos, sizeof(sv));
+    dv ^= sv;
+    std::memcpy(dst + pos, &dv, sizeof(dv));
+  }
+  for (; pos < size; pos++)
+    dst[pos] ^= src[pos];
+}
+
+void System::CompressMemoryStateDelta(MemorySaveState& mss, const MemorySaveState& next_mss)
+{
+  static constexpr int COMPRESSION_LEVEL = 1;
+
+  DebugAssert(!mss.state_is_delta && !next_mss.state_is_delta);
+
+  // Bytes past the end of the newer state are stored as-is, state sizes can differ slightly.
+  XORMemoryStateData(mss.state_data.data(), next_mss.state_data.data(), std::min(mss.state_size, next_mss.state_size));
+  mss.state_is_delta = true;
+
+  // Full-size buffer goes back to the spare, ready for the next state.
+  Error error;
+  CompressHelpers::ByteBuffer compressed;
+  if (CompressHelpers::CompressToBuffer(compressed, CompressHelpers::CompressType::Zstandard,
+                                        mss.state_data.cspan(0, mss.state_size), COMPRESSION_LEVEL, 0, &error))
+  {
+    mss.state_data.swap(s_state.memory_save_state_spare_data);
+    mss.state_data.swap(compressed);
+    mss.state_is_compressed = true;
+  }
+  else
+  {
+    ERROR_LOG("Failed to compress rewind state, storing uncompressed: {}", error.GetDescription());
+    mss.state_is_compressed = false;
+  }
+
+  UpdateMemoryStateDeltaSize(mss, true);
+}
+
+bool System::DecompressMemoryStateDelta(MemorySaveState& mss, const MemorySaveState& next_mss)
+{
+  DebugAssert(mss.state_is_delta && !next_mss.state_is_delta);
+  UpdateMemoryStateDeltaSize(mss, false);
+
+  if (mss.state_is_compressed)
+  {
+    const size_t size = GetMaxMemorySaveStateSize();
+    if (s_state.memory_save_state_spare_data.size() != size)
+      s_state.memory_save_state_spare_data.resize(size);
+
+    Error error;
+    if (!CompressHelpers::DecompressBuffer(s_state.memory_save_state_spare_data.span(0, mss.state_size),
+                                           CompressHelpers::CompressType::Zstandard, mss.state_data.cspan(),
+                                           mss.state_size, &error)
+           .has_value())
+    {
+      ERROR_LOG("Failed to decompress rewind state: {}", error.GetDescription());
+      mss.state_is_delta = false;
+      mss.state_is_compressed = false;
+      return false;
+    }
+
+    mss.state_data.swap(s_state.memory_save_state_spare_data);
+    mss.state_is_compressed = false;
+  }
+
+  XORMemoryStateData(mss.state_data.data(), next_mss.state_data.data(), std::min(mss.state_size, next_mss.state_size));
+  mss.state_is_delta = false;
+  return true;
+}
+
+void System::UpdateMemoryStateDeltaSize(const MemorySaveState& mss, bool add)
+{
+  if (add)
+  {
+    s_state.memory_save_state_delta_total_size += mss.state_data.size();
+    s_state.memory_save_state_delta_count++;
+  }
+  else
+  {
+    DebugAssert(s_state.memory_save_state_delta_count > 0);
+    s_state.memory_save_state_delta_total_size -= mss.state_data.size();
+    s_state.memory_save_state_delta_count--;
+  }
+
+  if (s_state.memory_save_state_delta_count > 0)
+  {
+    s_state.memory_save_state_average_delta_size.store(
+      static_cast<u32>(s_state.memory_save_state_delta_total_size / s_state.memory_save_state_delta_count),
+      std::memory_order_relaxed);
+  }
+}
+
 void System::DoMemoryState(StateWrapper& sw, MemorySaveState& mss, bool update_display)
 {
+  using PerformanceCounters::MemorySaveStateComponent;
+
+  // Each component's time and size goes to the performance counters, cheap enough to always do.
+  Timer::Value component_start_time = Timer::GetCurrentValue();
+  size_t component_start_pos = sw.GetPosition();
+  const auto end_component = [&sw, &component_start_time, &component_start_pos](MemorySaveStateComponent component) {
+    const Timer::Value time = Timer::GetCurrentValue();
+    const size_t pos = sw.GetPosition();
+    PerformanceCounters::AccumulateMemorySaveStateComponent(component, sw.IsReading(), time - component_start_time,
+                                                            pos - component_start_pos);
+    component_start_time = time;
+    component_start_pos = pos;
+  };
+
 #if defined(_DEBUG) || defined(_DEVEL)
 #define SAVE_COMPONENT(name, expr)                                                                                     \
   do                                                                                                                   \
   {                                                                                                                    \
-    Assert(sw.DoMarker(name));                                                                                         \
+    Assert(sw.DoMarker(#name));                                                                                        \
     if (!(expr)) [[unlikely]]                                                                                          \
-      Panic("Failed to memory save " name);                                                                            \
+      Panic("Failed to memory save " #name);                                                                           \
+    end_component(MemorySaveStateComponent::name);                                                                     \
   } while (0)
 #else
-#define SAVE_COMPONENT(name, expr) expr
+#define SAVE_COMPONENT(name, expr)                                                                                     \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    expr;                                                                                                              \
+    end_component(MemorySaveStateComponent::name);                                                                     \
+  } while (0)
 #endif
 
   sw.Do(&s_state.frame_number);
   sw.Do(&s_state.internal_frame_number);
 
-  SAVE_COMPONENT("CPU", CPU::DoState(sw));
+  SAVE_COMPONENT(CPU, CPU::DoState(sw));
   CPU::PGXP::DoState(sw);
+  end_component(MemorySaveStateComponent::PGXP);
 
-  if (sw.IsReading())
-    CPU::CodeCache::InvalidateAllRAMBlocks();
-
-  SAVE_COMPONENT("Bus", Bus::DoState(sw));
-  SAVE_COMPONENT("DMA", DMA::DoState(sw));
-  SAVE_COMPONENT("InterruptController", InterruptController::DoState(sw));
+  // Blocks in code pages which differ from the state are invalidated as RAM is loaded.
+  SAVE_COMPONENT(Bus, Bus::DoMemoryState(sw, mss));
+  SAVE_COMPONENT(DMA, DMA::DoState(sw));
+  SAVE_COMPONENT(InterruptController, InterruptController::DoState(sw));
 
   g_gpu.DoMemoryState(sw, mss);
+  end_component(MemorySaveStateComponent::GPU);
 
-  SAVE_COMPONENT("CDROM", CDROM::DoState(sw));
-  SAVE_COMPONENT("Pad", Pad::DoState(sw, true));
-  SAVE_COMPONENT("Timers", Timers::DoState(sw));
-  SAVE_COMPONENT("SPU", SPU::DoState(sw));
-  SAVE_COMPONENT("MDEC", MDEC::DoState(sw));
-  SAVE_COMPONENT("SIO", SIO::DoState(sw));
-  SAVE_COMPONENT("Events", TimingEvents::DoState(sw));
-  SAVE_COMPONENT("Achievements", Achievements::DoState(sw));
+  SAVE_COMPONENT(CDROM, CDROM::DoState(sw));
+  SAVE_COMPONENT(Pad, Pad::DoState(sw, true));
+  SAVE_COMPONENT(Timers, Timers::DoState(sw));
+  SAVE_COMPONENT(SPU, SPU::DoState(sw));
+  SAVE_COMPONENT(MDEC, MDEC::DoState(sw));
+  SAVE_COMPONENT(SIO, SIO::DoState(sw));
+  SAVE_COMPONENT(Events, TimingEvents::DoState(sw));
+  SAVE_COMPONENT(Achievements, Achievements::DoState(sw));
 
 #undef SAVE_COMPONENT
 
@@ -3207,6 +3447,9 @@ bool System::ReadAndDecompressStateData(std::FILE* fp, std::span<u8> dst, u32 fi
       type = CompressHelpers::CompressType::XZ;
       break;
 
+    case SAVE_STATE_HEADER::CompressionType::ChunkStore:
+      return SaveStateStore::ReadStateData(dst, compressed_data.cspan(), error);
+
     default:
       Error::SetStringFmt(error, "Unknown compression method {}", static_cast<u32>(method));
       return false;
@@ -3248,14 +3491,22 @@ bool System::SaveState(std::string path, Error* error, bool backup_existing_save
   // ensure multiple saves to the same path do not overlap
   FlushSaveStates();
 
+  const bool use_store = (g_settings.save_state_deduplication && SaveStateStore::IsStorePath(path));
+
   s_state.outstanding_save_state_tasks.fetch_add(1, std::memory_order_acq_rel);
   s_state.async_task_queue.SubmitTask([path = std::move(path), buffer = std::move(buffer), osd_key = std::move(osd_key),
-                                       backup_existing_save, compression = g_settings.save_state_compression]() {
+                                       backup_existing_save, compression = g_settings.save_state_compression,
+                                       use_store]() {
     INFO_LOG("Saving state to '{}'...", path);
 
     Error lerror;
     Timer lsave_timer;
 
+    // chunks referenced by the new state must not be collected before it's committed
+    std::unique_lock<std::mutex> store_lock;
+    if (use_store)
+      store_lock = SaveStateStore::GetLock();
+
     if (backup_existing_save && FileSystem::FileExists(path.c_str()))
     {
       const std::string backup_filename = Path::ReplaceExtension(path, "bak");
@@ -3270,7 +3521,7 @@ bool System::SaveState(std::string path, Error* error, bool backup_existing_save
     bool result = false;
     if (fp)
     {
-      if (SaveStateBufferToFile(buffer, fp.get(), &lerror, compression))
+      if (SaveStateBufferToFile(buffer, fp.get(), &lerror, compression, use_store))
         result = FileSystem::CommitAtomicRenamedFile(fp, &lerror);
       else
         FileSystem::DiscardAtomicRenamedFile(fp);
@@ -3280,6 +3531,27 @@ bool System::SaveState(std::string path, Error* error, bool backup_existing_save
       lerror.AddPrefixFmt("Cannot open '{}': ", Path::GetFileName(path));
     }
 
+    if (use_store)
+    {
+      store_lock.unlock();
+      if (SaveStateStore::ShouldCollectGarbage())
+        SaveStateStore::CollectGarbage();
+    }
+
+    // keep the state lists from having to re-read this state
+    FILESYSTEM_STAT_DATA sd;
+    if (result && FileSystem::StatFile(path.c_str(), &sd))
+    {
+      ExtendedSaveStateInfo ssi;
+      ssi.title = buffer.title;
+      ssi.serial = buffer.serial;
+      ssi.media_path = buffer.media_path;
+      ssi.timestamp = sd.ModificationTime;
+      ssi.screenshot = buffer.screenshot;
+      SaveStateIndex::Update(path, sd, ssi);
+      SaveStateIndex::Flush();
+    }
+
     VERBOSE_LOG("Saving state took {:.2f} msec", lsave_timer.GetTimeMilliseconds());
 
     s_state.outstanding_save_state_tasks.fetch_sub(1, std::memory_order_acq_rel);
@@ -3385,7 +3657,7 @@ bool System::SaveStateDataToBuffer(std::span<u8> data, size_t* data_size, Error*
 }
 
 bool System::SaveStateBufferToFile(const SaveStateBuffer& buffer, std::FILE* fp, Error* error,
-                                   SaveStateCompressionMode compression)
+                                   SaveStateCompressionMode compression, bool use_store)
 {
   // Header gets rewritten below.
   SAVE_STATE_HEADER header = {};
@@ -3436,8 +3708,17 @@ bool System::SaveStateBufferToFile(const SaveStateBuffer& buffer, std::FILE* fp,
   DebugAssert(buffer.state_size > 0);
   header.offset_to_data = file_position;
   header.data_uncompressed_size = static_cast<u32>(buffer.state_size);
-  header.data_compressed_size = CompressAndWriteStateData(fp, buffer.state_data.cspan(0, buffer.state_size),
-                                                          compression, &header.data_compression_type, error);
+  if (use_store)
+  {
+    header.data_compression_type = static_cast<u32>(SAVE_STATE_HEADER::CompressionType::ChunkStore);
+    header.data_compressed_size =
+      SaveStateStore::WriteStateData(fp, buffer.state_data.cspan(0, buffer.state_size), compression, error);
+  }
+  else
+  {
+    header.data_compressed_size = CompressAndWriteStateData(fp, buffer.state_data.cspan(0, buffer.state_size),
+                                                            compression, &header.data_compression_type, error);
+  }
   if (header.data_compressed_size == 0)
     return false;
 
@@ -3461,21 +3742,16 @@ bool System::SaveStateBufferToFile(const SaveStateBuffer& buffer, std::FILE* fp,
 u32 System::CompressAndWriteStateData(std::FILE* fp, std::span<const u8> src, SaveStateCompressionMode method,
                                       u32* header_type, Error* error)
 {
+  CompressHelpers::CompressType ctype;
+  int clevel;
+  u32 num_workers = 0;
   if (method == SaveStateCompressionMode::Uncompressed)
   {
-    if (std::fwrite(src.data(), src.size(), 1, fp) != 1) [[unlikely]]
-    {
-      Error::SetStringFmt(error, "fwrite() failed: {}", errno);
-      return 0;
-    }
-
+    ctype = CompressHelpers::CompressType::Uncompressed;
     *header_type = static_cast<u32>(SAVE_STATE_HEADER::CompressionType::None);
-    return static_cast<u32>(src.size());
+    clevel = -1;
   }
-
-  CompressHelpers::CompressType ctype;
-  int clevel;
-  if (method >= SaveStateCompressionMode::DeflateLow && method <= SaveStateCompressionMode::DeflateHigh)
+  else if (method >= SaveStateCompressionMode::DeflateLow && method <= SaveStateCompressionMode::DeflateHigh)
   {
     ctype = CompressHelpers::CompressType::Deflate;
     *header_type = static_cast<u32>(SAVE_STATE_HEADER::CompressionType::Deflate);
@@ -3489,12 +3765,17 @@ u32 System::CompressAndWriteStateData(std::FILE* fp, std::span<const u8> src, Sa
     *header_type = static_cast<u32>(SAVE_STATE_HEADER::CompressionType::Zstandard);
     clevel =
       ((method == SaveStateCompressionMode::ZstLow) ? 1 : ((method == SaveStateCompressionMode::ZstHigh) ? 18 : 0));
+
+    // low is already fast enough that spinning up threads costs more than it saves
+    if (method != SaveStateCompressionMode::ZstLow)
+      num_workers = CompressHelpers::GetDefaultWorkerCount();
   }
   else if (method >= SaveStateCompressionMode::XZLow && method <= SaveStateCompressionMode::XZHigh)
   {
     ctype = CompressHelpers::CompressType::XZ;
     *header_type = static_cast<u32>(SAVE_STATE_HEADER::CompressionType::XZ);
     clevel = ((method == SaveStateCompressionMode::XZLow) ? 1 : ((method == SaveStateCompressionMode::XZHigh) ? 9 : 5));
+    num_workers = CompressHelpers::GetDefaultWorkerCount();
   }
   else
   {
@@ -3502,18 +3783,13 @@ u32 System::CompressAndWriteStateData(std::FILE* fp, std::span<const u8> src, Sa
     return 0;
   }
 
-  const CompressHelpers::OptionalByteBuffer compressed_data =
-    CompressHelpers::CompressToBuffer(ctype, src, clevel, error);
-  if (!compressed_data.has_value())
+  // compressed data goes straight to the file in chunks, rather than allocating a second state-sized buffer
+  const std::optional<size_t> compressed_size =
+    CompressHelpers::CompressToStream(fp, ctype, src, clevel, num_workers, error);
+  if (!compressed_size.has_value())
     return 0;
 
-  if (std::fwrite(compressed_data->data(), compressed_data->size(), 1, fp) != 1) [[unlikely]]
-  {
-    Error::SetStringFmt(error, "fwrite() failed: {}", errno);
-    return 0;
-  }
-
-  return static_cast<u32>(compressed_data->size());
+  return static_cast<u32>(compressed_size.value());
 }
 
 float System::GetTargetSpeed()
@@ -4118,6 +4394,7 @@ void System::UpdateRunningGame(const std::string& path, CDImage* image, bool boo
 
   UpdateGameSettingsLayer();
   ApplySettings(true);
+  CPU::CodeCache::UpdatePersistentCache();
 
   if (!IsReplayingGPUDump())
   {
@@ -4413,6 +4690,9 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         (g_settings.cpu_recompiler_memory_exceptions != old_settings.cpu_recompiler_memory_exceptions ||
          g_settings.cpu_recompiler_block_linking != old_settings.cpu_recompiler_block_linking ||
          g_settings.cpu_recompiler_icache != old_settings.cpu_recompiler_icache ||
+         g_settings.cpu_recompiler_traces != old_settings.cpu_recompiler_traces ||
+         g_settings.cpu_recompiler_block_profiling != old_settings.cpu_recompiler_block_profiling ||
+         g_settings.cpu_recompiler_idle_loop_skipping != old_settings.cpu_recompiler_idle_loop_skipping ||
          g_settings.bios_tty_logging != old_settings.bios_tty_logging))
     {
       Host::AddIconOSDMessage("CPUFlushAllBlocks", ICON_FA_MICROCHIP,
@@ -4429,6 +4709,12 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         InterruptExecution();
     }
 
+    if (g_settings.cpu_recompiler_block_cache != old_settings.cpu_recompiler_block_cache ||
+        g_settings.cpu_execution_mode != old_settings.cpu_execution_mode)
+    {
+      CPU::CodeCache::UpdatePersistentCache();
+    }
+
     if (g_settings.cpu_fastmem_mode != old_settings.cpu_fastmem_mode)
     {
       // Reallocate fastmem area, even if it's not being used.
@@ -4466,6 +4752,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
              g_settings.gpu_max_queued_frames != old_settings.gpu_max_queued_frames ||
              g_settings.gpu_use_software_renderer_for_readbacks !=
                old_settings.gpu_use_software_renderer_for_readbacks ||
+             g_settings.gpu_software_renderer_threads != old_settings.gpu_software_renderer_threads ||
+             g_settings.gpu_software_renderer_scale != old_settings.gpu_software_renderer_scale ||
              g_settings.gpu_scaled_interlacing != old_settings.gpu_scaled_interlacing ||
              g_settings.gpu_force_round_texcoords != old_settings.gpu_force_round_texcoords ||
              g_settings.gpu_texture_filter != old_settings.gpu_texture_filter ||
@@ -4611,6 +4899,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
         g_settings.rewind_save_frequency != old_settings.rewind_save_frequency ||
         g_settings.rewind_save_slots != old_settings.rewind_save_slots ||
+        g_settings.rewind_compression != old_settings.rewind_compression ||
+        g_settings.memory_save_state_snapshot_mode != old_settings.memory_save_state_snapshot_mode ||
         g_settings.runahead_frames != old_settings.runahead_frames)
     {
       UpdateMemorySaveStateSettings();
@@ -4939,10 +5229,22 @@ void System::LogUnsafeSettingsToConsole(const SmallStringBase& messages)
   WARNING_LOG(console_messages);
 }
 
-void System::CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64* ram_usage, u64* vram_usage)
+void System::CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, bool compression, u64* ram_usage,
+                                        u64* vram_usage)
 {
   const u64 real_resolution_scale = std::max<u64>(g_settings.gpu_resolution_scale, 1u);
-  *ram_usage = GetMaxMemorySaveStateSize() * static_cast<u64>(num_saves);
+  const u64 state_size = GetMaxMemorySaveStateSize();
+  if (compression && num_saves > 1)
+  {
+    // Newest state and the spare buffer are uncompressed. Without any deltas measured yet, assume the worst case.
+    const u32 average_delta_size = s_state.memory_save_state_average_delta_size.load(std::memory_order_relaxed);
+    const u64 delta_size = (average_delta_size > 0) ? average_delta_size : state_size;
+    *ram_usage = (state_size * 2) + (delta_size * static_cast<u64>(num_saves - 1));
+  }
+  else
+  {
+    *ram_usage = state_size * static_cast<u64>(num_saves);
+  }
   *vram_usage = ((VRAM_WIDTH * real_resolution_scale) * (VRAM_HEIGHT * real_resolution_scale) * 4) *
                 static_cast<u64>(g_settings.gpu_multisamples) * static_cast<u64>(num_saves);
 }
@@ -4967,16 +5269,20 @@ void System::UpdateMemorySaveStateSettings()
     s_state.rewind_save_counter = 0;
     num_slots = g_settings.rewind_save_slots;
 
+    s_state.memory_save_state_compression = g_settings.rewind_compression;
+
     u64 ram_usage, vram_usage;
-    CalculateRewindMemoryUsage(g_settings.rewind_save_slots, g_settings.gpu_resolution_scale, &ram_usage, &vram_usage);
-    INFO_LOG("Rewind is enabled, saving every {} frames, with {} slots and {}MB RAM and {}MB VRAM usage",
+    CalculateRewindMemoryUsage(g_settings.rewind_save_slots, g_settings.gpu_resolution_scale,
+                               g_settings.rewind_compression, &ram_usage, &vram_usage);
+    INFO_LOG("Rewind is enabled, saving every {} frames, with {} slots and {}MB RAM{} and {}MB VRAM usage",
              std::max(s_state.rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576,
-             vram_usage / 1048576);
+             g_settings.rewind_compression ? " (compressed)" : "", vram_usage / 1048576);
   }
   else
   {
     s_state.rewind_save_frequency = -1;
     s_state.rewind_save_counter = -1;
+    s_state.memory_save_state_compression = false;
   }
 
   s_state.rewind_load_frequency = -1;
@@ -4984,16 +5290,33 @@ void System::UpdateMemorySaveStateSettings()
 
   s_state.runahead_frames = g_settings.runahead_frames;
   s_state.runahead_replay_pending = false;
+  if (s_state.runahead_replay_frames > 0)
+  {
+    // states were thrown away above, so any replay in progress can't continue
+    s_state.runahead_replay_frames = 0;
+    SPU::SetAudioOutputMuted(false);
+    UpdateRunaheadHeadlessReplay();
+  }
   if (s_state.runahead_frames > 0)
   {
     INFO_LOG("Runahead is active with {} frames", s_state.runahead_frames);
     num_slots = s_state.runahead_frames;
   }
 
+  // compression happens on a worker thread, otherwise the task is deferred until WaitForAll() runs it
+  s_state.memory_save_state_task_queue.SetWorkerCount(s_state.memory_save_state_compression ? 1 : 0);
+
   // allocate storage for memory save states
   if (num_slots > 0)
     AllocateMemoryStates(num_slots, true);
 
+  // recompiled code may need to flag written pages so unchanged RAM can be skipped
+  if (Bus::SetRAMSnapshotMode((num_slots > 0) ? g_settings.memory_save_state_snapshot_mode :
+                                                MemorySaveStateSnapshotMode::Full))
+  {
+    CPU::CodeCache::Reset();
+  }
+
   // reenter execution loop, don't want to try to save a state now if runahead was turned off
   InterruptExecution();
 }
@@ -5110,6 +5433,7 @@ bool System::DoRunahead()
 
     // run the frames with no audio
     SPU::SetAudioOutputMuted(true);
+    UpdateRunaheadHeadlessReplay();
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
     VERBOSE_LOG("Rewound to frame {}, took {:.2f} ms", s_state.frame_number, replay_timer.GetTimeMilliseconds());
@@ -5127,6 +5451,7 @@ bool System::DoRunahead()
   }
 
   s_state.runahead_replay_frames--;
+  UpdateRunaheadHeadlessReplay();
   if (s_state.runahead_replay_frames > 0)
   {
     // keep running ahead
@@ -5149,6 +5474,15 @@ bool System::DoRunahead()
   return false;
 }
 
+void System::UpdateRunaheadHeadlessReplay()
+{
+  // Frames which are replayed and never displayed don't need to be rendered or mixed.
+  const bool headless =
+    (g_settings.runahead_headless_replay && s_state.runahead_replay_frames > RUNAHEAD_HEADLESS_RENDERED_FRAMES);
+  g_gpu.SetDiscardDrawCommands(headless);
+  SPU::SetDiscardVoiceOutput(headless);
+}
+
 void System::SetRunaheadReplayFlag(bool is_analog_input)
 {
   if (s_state.runahead_frames == 0 || s_state.memory_save_state_count == 0)
@@ -5574,12 +5908,26 @@ std::optional<SaveStateInfo> System::GetSaveStateInfo(std::string_view serial, s
   return SaveStateInfo{std::move(path), sd.ModificationTime, slot, global};
 }
 
+void System::FlushSaveStateIndex()
+{
+  SaveStateIndex::Flush();
+}
+
 std::optional<ExtendedSaveStateInfo> System::GetExtendedSaveStateInfo(const char* path)
 {
   std::optional<ExtendedSaveStateInfo> ssi;
 
   FlushSaveStates();
 
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(path, &sd))
+    return ssi;
+
+  // avoid opening and decompressing the screenshot if it hasn't changed
+  ssi = SaveStateIndex::Lookup(path, sd);
+  if (ssi.has_value())
+    return ssi;
+
   Error error;
   auto fp = FileSystem::OpenManagedCFile(path, "rb", &error);
   if (fp)
@@ -5593,9 +5941,8 @@ std::optional<ExtendedSaveStateInfo> System::GetExtendedSaveStateInfo(const char
       ssi->serial = std::move(buffer.serial);
       ssi->media_path = std::move(buffer.media_path);
       ssi->screenshot = std::move(buffer.screenshot);
-
-      FILESYSTEM_STAT_DATA sd;
-      ssi->timestamp = FileSystem::StatFile(fp.get(), &sd) ? sd.ModificationTime : 0;
+      ssi->timestamp = sd.ModificationTime;
+      SaveStateIndex::Update(path, sd, ssi.value());
     }
     else
     {
@@ -5621,6 +5968,9 @@ void System::DeleteSaveStates(std::string_view serial, bool resume)
     if (!FileSystem::DeleteFile(si.path.c_str(), &error)) [[unlikely]]
       ERROR_LOG("Failed to delete save state file '{}': {}", Path::GetFileName(si.path), error.GetDescription());
   }
+
+  // drop any chunks which were only used by the deleted states
+  s_state.async_task_queue.SubmitTask(&SaveStateStore::CollectGarbage);
 }
 
 std::string System::GetGameMemoryCardPath(std::string_view serial, std::string_view path, u32 slot,
@@ -387,8 +387,12 @@ std::vector<SaveStateInfo> GetAvailableSaveStates(std::string_view serial);
 std::optional<SaveStateInfo> GetSaveStateInfo(std::string_view serial, s32 slot);
 
 /// Returns save state info from opened save state stream.
+/// States which had to be read are added to the save state index, call FlushSaveStateIndex() once done listing.
 std::optional<ExtendedSaveStateInfo> GetExtendedSaveStateInfo(const char* path);
 
+/// Writes the save state index if any states were added to it by GetExtendedSaveStateInfo().
+void FlushSaveStateIndex();
+
 /// Deletes save states for the specified game code. If resume is set, the resume state is deleted too.
 void DeleteSaveStates(std::string_view serial, bool resume);
 
@@ -435,7 +439,8 @@ std::string GetImageForLoadingScreen(const std::string& game_path);
 //////////////////////////////////////////////////////////////////////////
 // Memory Save States (Rewind and Runahead)
 //////////////////////////////////////////////////////////////////////////
-void CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64* ram_usage, u64* vram_usage);
+void CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, bool compression, u64* ram_usage,
+                                u64* vram_usage);
 void ClearMemorySaveStates(bool reallocate_resources, bool recycle_textures);
 void SetRunaheadReplayFlag(bool is_analog_input);
 
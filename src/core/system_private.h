@@ -18,6 +18,15 @@ struct MemorySaveState
   DynamicHeapArray<u8> state_data;
   size_t state_size;
 
+  // With rewind compression, all but the newest state are stored as a delta against the next newer state.
+  bool state_is_delta;
+  bool state_is_compressed;
+
+  // RAM in state_data is only updated for pages modified since ram_generation, zero if the copy is invalid.
+  u32 ram_offset;
+  u32 ram_size;
+  u64 ram_generation;
+
   std::unique_ptr<GPUTexture> vram_texture;
   DynamicHeapArray<u8> gpu_state_data;
   size_t gpu_state_size;
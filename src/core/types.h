@@ -313,6 +313,15 @@ enum class SaveStateCompressionMode : u8
   Count,
 };
 
+enum class MemorySaveStateSnapshotMode : u8
+{
+  Full,
+  WriteTracking,
+  SoftDirty,
+
+  Count,
+};
+
 enum class ForceVideoTimingMode : u8
 {
   Disabled,
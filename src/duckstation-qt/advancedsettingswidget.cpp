@@ -111,6 +111,26 @@ static QComboBox* addChoiceTweakOption(SettingsWindow* dialog, QTableWidget* tab
   return cb;
 }
 
+static QComboBox* addChoiceTweakOption(SettingsWindow* dialog, QTableWidget* table, QString name, std::string section,
+                                       std::string key, const char** names, const char** values,
+                                       const char* default_value)
+{
+  const int row = table->rowCount();
+
+  table->insertRow(row);
+
+  QTableWidgetItem* name_item = new QTableWidgetItem(name);
+  name_item->setFlags(name_item->flags() & ~(Qt::ItemIsEditable | Qt::ItemIsSelectable));
+  table->setItem(row, 0, name_item);
+
+  QComboBox* cb = new QComboBox(table);
+  SettingWidgetBinder::BindWidgetToEnumSetting(dialog->getSettingsInterface(), cb, std::move(section), std::move(key),
+                                               names, values, default_value);
+
+  table->setCellWidget(row, 1, cb);
+  return cb;
+}
+
 template<typename T>
 static void setChoiceTweakOption(QTableWidget* table, int row, T value)
 {
@@ -264,6 +284,14 @@ void AdvancedSettingsWidget::addTweakOptions()
                        &Settings::GetSaveStateCompressionModeDisplayName,
                        static_cast<u32>(SaveStateCompressionMode::Count),
                        Settings::DEFAULT_SAVE_STATE_COMPRESSION_MODE);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Deduplicate Save States"), "Main",
+                        "SaveStateDeduplication", false);
+  addChoiceTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Rewind/Runahead Snapshot Mode"), "Main",
+                       "MemorySaveStateSnapshot", &Settings::ParseMemorySaveStateSnapshotModeName,
+                       &Settings::GetMemorySaveStateSnapshotModeName,
+                       &Settings::GetMemorySaveStateSnapshotModeDisplayName,
+                       static_cast<u32>(MemorySaveStateSnapshotMode::Count),
+                       Settings::DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE);
 
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Disable Window Rounded Corners"), "Main",
                         "DisableWindowRoundedCorners", false);
@@ -288,11 +316,25 @@ void AdvancedSettingsWidget::addTweakOptions()
                          Settings::DEFAULT_GPU_FIFO_SIZE, tr(" words"));
   addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("GPU Max Runahead"), "Hacks", "GPUMaxRunAhead", 0, 1000,
                          Settings::DEFAULT_GPU_MAX_RUN_AHEAD, tr(" cycles"));
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Software Renderer Threads"), "GPU",
+                         "SoftwareRendererThreads", 0, 32, 0);
+  static const char* software_renderer_scale_names[] = {"1x", "2x", "4x", nullptr};
+  static const char* software_renderer_scale_values[] = {"1", "2", "4", nullptr};
+  addChoiceTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Software Renderer Scale"), "GPU", "SoftwareRendererScale",
+                       software_renderer_scale_names, software_renderer_scale_values, "1");
 
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Memory Exceptions"), "CPU",
                         "RecompilerMemoryExceptions", false);
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Block Linking"), "CPU",
                         "RecompilerBlockLinking", true);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Block Cache"), "CPU",
+                        "RecompilerBlockCache", false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Traces"), "CPU", "RecompilerTraces",
+                        false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Block Profiling"), "CPU",
+                        "RecompilerBlockProfiling", false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Skip Recompiler Idle Loops"), "CPU",
+                        "RecompilerIdleLoopSkipping", false);
   addChoiceTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Fast Memory Access"), "CPU",
                        "FastmemMode", Settings::ParseCPUFastmemMode, Settings::GetCPUFastmemModeName,
                        Settings::GetCPUFastmemModeDisplayName, static_cast<u32>(CPUFastmemMode::Count),
@@ -340,6 +382,9 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false); // Load Devices From Save States
     setChoiceTweakOption(m_ui.tweakOptionTable, i++,
                          Settings::DEFAULT_SAVE_STATE_COMPRESSION_MODE); // Save State Compression
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);            // Deduplicate Save States
+    setChoiceTweakOption(m_ui.tweakOptionTable, i++,
+                         Settings::DEFAULT_MEMORY_SAVE_STATE_SNAPSHOT_MODE); // Rewind/Runahead Snapshot Mode
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);            // Disable Window Rounded Corners
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                            static_cast<int>(Settings::DEFAULT_DMA_MAX_SLICE_TICKS)); // DMA max slice ticks
@@ -349,8 +394,14 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
                            static_cast<int>(Settings::DEFAULT_GPU_FIFO_SIZE)); // GPU FIFO size
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                            static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD)); // GPU max runahead
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++, 0);                         // Software renderer threads
+    setChoiceTweakOption(m_ui.tweakOptionTable, i++, 0);                           // Software renderer scale
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler memory exceptions
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, true);                       // Recompiler block linking
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler block cache
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler traces
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler block profiling
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler idle loop skipping
     setChoiceTweakOption(m_ui.tweakOptionTable, i++,
                          Settings::DEFAULT_CPU_FASTMEM_MODE); // Recompiler fastmem mode
     setChoiceTweakOption(m_ui.tweakOptionTable, i++,
@@ -381,6 +432,8 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   sif->DeleteValue("Main", "ApplyCompatibilitySettings");
   sif->DeleteValue("Main", "LoadDevicesFromSaveStates");
   sif->DeleteValue("Main", "CompressSaveStates");
+  sif->DeleteValue("Main", "SaveStateDeduplication");
+  sif->DeleteValue("Main", "MemorySaveStateSnapshot");
   sif->DeleteValue("Main", "DisableWindowRoundedCorners");
   sif->DeleteValue("Display", "ActiveStartOffset");
   sif->DeleteValue("Display", "ActiveEndOffset");
@@ -390,9 +443,15 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   sif->DeleteValue("Hacks", "DMAHaltTicks");
   sif->DeleteValue("Hacks", "GPUFIFOSize");
   sif->DeleteValue("Hacks", "GPUMaxRunAhead");
+  sif->DeleteValue("GPU", "SoftwareRendererThreads");
+  sif->DeleteValue("GPU", "SoftwareRendererScale");
   sif->DeleteValue("Hacks", "ExportSharedMemory");
   sif->DeleteValue("CPU", "RecompilerMemoryExceptions");
   sif->DeleteValue("CPU", "RecompilerBlockLinking");
+  sif->DeleteValue("CPU", "RecompilerBlockCache");
+  sif->DeleteValue("CPU", "RecompilerTraces");
+  sif->DeleteValue("CPU", "RecompilerBlockProfiling");
+  sif->DeleteValue("CPU", "RecompilerIdleLoopSkipping");
   sif->DeleteValue("CPU", "FastmemMode");
   sif->DeleteValue("CDROM", "MechaconVersion");
   sif->DeleteValue("CDROM", "ReadaheadSectors");
@@ -30,9 +30,12 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindEnable, "Main", "RewindEnable", false);
   SettingWidgetBinder::BindWidgetToFloatSetting(sif, m_ui.rewindSaveFrequency, "Main", "RewindFrequency", 10.0f);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.rewindSaveSlots, "Main", "RewindSaveSlots", 10);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindCompression, "Main", "RewindCompression", false);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.runaheadFrames, "Main", "RunaheadFrameCount", 0);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.runaheadForAnalogInput, "Main", "RunaheadForAnalogInput",
                                                false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.runaheadHeadlessReplay, "Main", "RunaheadHeadlessReplay",
+                                               false);
 
   const float effective_emulation_speed = m_dialog->getEffectiveFloatValue("Main", "EmulationSpeed", 1.0f);
   fillComboBoxWithEmulationSpeeds(m_ui.emulationSpeed, effective_emulation_speed);
@@ -90,6 +93,7 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
           &EmulationSettingsWidget::updateRewind);
   connect(m_ui.rewindSaveSlots, QOverload<int>::of(&QSpinBox::valueChanged), this,
           &EmulationSettingsWidget::updateRewind);
+  connect(m_ui.rewindCompression, &QCheckBox::checkStateChanged, this, &EmulationSettingsWidget::updateRewind);
   connect(m_ui.runaheadFrames, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
           &EmulationSettingsWidget::updateRewind);
 
@@ -142,6 +146,10 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
        "requirements.<br> "
        "<b>Rewind Buffer Size:</b> How many saves will be kept for rewinding. Higher values have greater memory "
        "requirements."));
+  dialog->registerWidgetHelp(
+    m_ui.rewindCompression, tr("Compress Rewind States"), tr("Unchecked"),
+    tr("Stores older rewind states as compressed differences, allowing many more slots in the same amount of memory, "
+       "at a small CPU cost when saving and rewinding."));
   dialog->registerWidgetHelp(
     m_ui.runaheadFrames, tr("Runahead"), tr("Disabled"),
     tr(
@@ -149,6 +157,10 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
   dialog->registerWidgetHelp(
     m_ui.runaheadForAnalogInput, tr("Enable for Analog Input"), tr("Unchecked"),
     tr("Activates runahead when analog input changes, which significantly increases system requirements."));
+  dialog->registerWidgetHelp(
+    m_ui.runaheadHeadlessReplay, tr("Skip Rendering Replayed Frames"), tr("Unchecked"),
+    tr("Discards draw commands and audio for frames that are replayed by runahead and never displayed. Greatly "
+       "reduces the cost of runahead, but may cause graphical errors in games that reuse previous frames."));
 
   onOptimalFramePacingChanged();
   updateSkipDuplicateFramesEnabled();
@@ -245,6 +257,7 @@ void EmulationSettingsWidget::updateRewind()
   const bool runahead_enabled = m_dialog->getIntValue("Main", "RunaheadFrameCount", 0) > 0;
   m_ui.rewindEnable->setEnabled(!runahead_enabled);
   m_ui.runaheadForAnalogInput->setEnabled(runahead_enabled);
+  m_ui.runaheadHeadlessReplay->setEnabled(runahead_enabled);
 
   if (!runahead_enabled && rewind_enabled)
   {
@@ -255,7 +268,8 @@ void EmulationSettingsWidget::updateRewind()
       ((frequency <= std::numeric_limits<float>::epsilon()) ? (1.0f / 60.0f) : frequency) * static_cast<float>(frames);
 
     u64 ram_usage, vram_usage;
-    System::CalculateRewindMemoryUsage(frames, resolution_scale, &ram_usage, &vram_usage);
+    System::CalculateRewindMemoryUsage(frames, resolution_scale, m_ui.rewindCompression->isChecked(), &ram_usage,
+                                       &vram_usage);
 
     m_ui.rewindSummary->setText(
       tr("Rewind for %n frame(s), lasting %1 second(s) will require up to %2MB of RAM and %3MB of VRAM.", "", frames)
@@ -264,6 +278,7 @@ void EmulationSettingsWidget::updateRewind()
         .arg(vram_usage / 1048576));
     m_ui.rewindSaveFrequency->setEnabled(true);
     m_ui.rewindSaveSlots->setEnabled(true);
+    m_ui.rewindCompression->setEnabled(true);
   }
   else
   {
@@ -279,5 +294,6 @@ void EmulationSettingsWidget::updateRewind()
     }
     m_ui.rewindSaveFrequency->setEnabled(false);
     m_ui.rewindSaveSlots->setEnabled(false);
+    m_ui.rewindCompression->setEnabled(false);
   }
 }
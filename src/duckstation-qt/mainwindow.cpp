@@ -1155,6 +1155,7 @@ bool MainWindow::openResumeStateDialog(const std::string& path, const std::strin
     return false;
 
   std::optional<ExtendedSaveStateInfo> ssi = System::GetExtendedSaveStateInfo(save_state_path.c_str());
+  System::FlushSaveStateIndex();
   if (!ssi.has_value())
     return false;
 
@@ -2642,6 +2643,8 @@ void MainWindow::connectSignals()
                                                false);
   SettingWidgetBinder::BindWidgetToBoolSetting(nullptr, m_ui.actionDebugShowMDECState, "DebugWindows", "MDEC", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(nullptr, m_ui.actionDebugShowDMAState, "DebugWindows", "DMA", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(nullptr, m_ui.actionDebugShowMemorySaveStateTiming, "DebugWindows",
+                                               "MemorySaveStates", false);
 
   // Set status tip to the same as tooltip for accessibility.
   for (QAction* action : findChildren<QAction*>())
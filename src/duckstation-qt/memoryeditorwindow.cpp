@@ -522,7 +522,8 @@ void MemoryEditorWindow::updateMemoryViewRegion()
 
     const u32 start_page = static_cast<u32>(offset) >> HOST_PAGE_SHIFT;
     const u32 end_page = static_cast<u32>(offset + count - 1) >> HOST_PAGE_SHIFT;
-    Host::RunOnCPUThread([start_page, end_page]() {
+    Host::RunOnCPUThread([offset, count, start_page, end_page]() {
+      Bus::MarkRAMRangeDirty(static_cast<u32>(offset), static_cast<u32>(count));
       for (u32 i = start_page; i <= end_page; i++)
       {
         if (Bus::g_ram_code_bits[i])
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "util/compress_helpers.h"
+
+#include "common/error.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Larger than the streaming chunk size, so the output is written in several pieces.
+static CompressHelpers::ByteBuffer GenerateTestData(size_t size = 1024 * 1024)
+{
+  CompressHelpers::ByteBuffer data(size);
+  u32 seed = 0x12345678u;
+  for (size_t i = 0; i < size; i++)
+  {
+    // mix of runs and noise so it compresses, but not trivially
+    seed = seed * 1103515245u + 12345u;
+    data[i] = ((i & 0x3FF) < 0x200) ? static_cast<u8>(i >> 10) : static_cast<u8>(seed >> 16);
+  }
+
+  return data;
+}
+
+static void TestStreamRoundTrip(CompressHelpers::CompressType type, int clevel, u32 num_workers = 0,
+                                size_t data_size = 1024 * 1024)
+{
+  const CompressHelpers::ByteBuffer data = GenerateTestData(data_size);
+
+  std::FILE* fp = std::tmpfile();
+  ASSERT_NE(fp, nullptr);
+
+  Error error;
+  const std::optional<size_t> written =
+    CompressHelpers::CompressToStream(fp, type, data.cspan(), clevel, num_workers, &error);
+  ASSERT_TRUE(written.has_value()) << error.GetDescription();
+  EXPECT_EQ(static_cast<long>(written.value()), std::ftell(fp));
+
+  CompressHelpers::ByteBuffer compressed(written.value());
+  std::rewind(fp);
+  ASSERT_EQ(std::fread(compressed.data(), compressed.size(), 1, fp), 1u);
+  std::fclose(fp);
+
+  const CompressHelpers::OptionalByteBuffer decompressed =
+    CompressHelpers::DecompressBuffer(type, compressed.cspan(), data.size(), &error);
+  ASSERT_TRUE(decompressed.has_value()) << error.GetDescription();
+  ASSERT_EQ(decompressed->size(), data.size());
+  EXPECT_EQ(std::memcmp(decompressed->data(), data.data(), data.size()), 0);
+}
+
+} // namespace
+
+TEST(CompressHelpers, StreamUncompressed)
+{
+  TestStreamRoundTrip(CompressHelpers::CompressType::Uncompressed, -1);
+}
+
+TEST(CompressHelpers, StreamDeflate)
+{
+  TestStreamRoundTrip(CompressHelpers::CompressType::Deflate, 6);
+}
+
+TEST(CompressHelpers, StreamZstandard)
+{
+  TestStreamRoundTrip(CompressHelpers::CompressType::Zstandard, 3);
+}
+
+TEST(CompressHelpers, StreamXZ)
+{
+  TestStreamRoundTrip(CompressHelpers::CompressType::XZ, 5);
+}
+
+TEST(CompressHelpers, StreamZstandardMultiThreaded)
+{
+  TestStreamRoundTrip(CompressHelpers::CompressType::Zstandard, 19, 4, 6 * 1024 * 1024);
+}
+
+TEST(CompressHelpers, StreamXZMultiThreaded)
+{
+  // split into independent streams, which must decode back to one buffer
+  TestStreamRoundTrip(CompressHelpers::CompressType::XZ, 5, 4, 6 * 1024 * 1024 + 1234);
+}
+
+TEST(CompressHelpers, BufferXZMultiThreaded)
+{
+  const CompressHelpers::ByteBuffer data = GenerateTestData(3 * 1024 * 1024);
+
+  Error error;
+  const CompressHelpers::OptionalByteBuffer compressed =
+    CompressHelpers::CompressToBuffer(CompressHelpers::CompressType::XZ, data.cspan(), 5, 3, &error);
+  ASSERT_TRUE(compressed.has_value()) << error.GetDescription();
+
+  const std::optional<size_t> size =
+    CompressHelpers::GetDecompressedSize(CompressHelpers::CompressType::XZ, compressed->cspan(), &error);
+  ASSERT_TRUE(size.has_value()) << error.GetDescription();
+  EXPECT_EQ(size.value(), data.size());
+
+  const CompressHelpers::OptionalByteBuffer decompressed =
+    CompressHelpers::DecompressBuffer(CompressHelpers::CompressType::XZ, compressed->cspan(), data.size(), &error);
+  ASSERT_TRUE(decompressed.has_value()) << error.GetDescription();
+  ASSERT_EQ(decompressed->size(), data.size());
+  EXPECT_EQ(std::memcmp(decompressed->data(), data.data(), data.size()), 0);
+}
+
+TEST(CompressHelpers, StreamZstandardHasContentSize)
+{
+  const CompressHelpers::ByteBuffer data = GenerateTestData();
+
+  std::FILE* fp = std::tmpfile();
+  ASSERT_NE(fp, nullptr);
+
+  const std::optional<size_t> written =
+    CompressHelpers::CompressToStream(fp, CompressHelpers::CompressType::Zstandard, data.cspan());
+  ASSERT_TRUE(written.has_value());
+
+  CompressHelpers::ByteBuffer compressed(written.value());
+  std::rewind(fp);
+  ASSERT_EQ(std::fread(compressed.data(), compressed.size(), 1, fp), 1u);
+  std::fclose(fp);
+
+  // should be interchangeable with ZSTD_compress() output, which records the size in the frame
+  const std::optional<size_t> size =
+    CompressHelpers::GetDecompressedSize(CompressHelpers::CompressType::Zstandard, compressed.cspan());
+  ASSERT_TRUE(size.has_value());
+  EXPECT_EQ(size.value(), data.size());
+}
+
+TEST(CompressHelpers, StreamEmptyBufferFails)
+{
+  std::FILE* fp = std::tmpfile();
+  ASSERT_NE(fp, nullptr);
+
+  EXPECT_FALSE(
+    CompressHelpers::CompressToStream(fp, CompressHelpers::CompressType::Zstandard, std::span<const u8>()).has_value());
+  std::fclose(fp);
+}
@@ -11,6 +11,7 @@
 #include "common/path.h"
 #include "common/scoped_guard.h"
 #include "common/string_util.h"
+#include "common/task_queue.h"
 
 #include "7zCrc.h"
 #include "Alloc.h"
@@ -18,6 +19,8 @@
 #include "XzCrc64.h"
 #include "XzEnc.h"
 
+#include <thread>
+#include <vector>
 #include <zlib.h>
 #include <zstd.h>
 #include <zstd_errors.h>
@@ -41,10 +44,33 @@ static bool DecompressHelper(ByteBuffer& ret, CompressType type, T data, std::op
                              Error* error);
 
 template<typename T>
-static bool CompressHelper(ByteBuffer& ret, CompressType type, T data, int clevel, Error* error);
+static bool CompressHelper(ByteBuffer& ret, CompressType type, T data, int clevel, u32 num_workers, Error* error);
+
+static bool WriteStreamChunk(std::FILE* fp, const void* data, size_t size, Error* error);
+static std::optional<size_t> DeflateCompressToStream(std::FILE* fp, std::span<const u8> data, int clevel,
+                                                     Error* error);
+static void SetZstdCompressParameters(ZSTD_CCtx* cctx, int clevel, u32 num_workers, size_t data_size);
+static std::optional<size_t> ZstdCompressToStream(std::FILE* fp, std::span<const u8> data, int clevel, u32 num_workers,
+                                                  Error* error);
 
 static void Init7ZCRCTables();
+static bool XzEncode(ISeqOutStream* out_stream, const u8* data, size_t data_size, int clevel, Error* error);
 static bool XzCompress(ByteBuffer& ret, const u8* data, size_t data_size, int clevel, Error* error);
+static size_t GetXzSegmentCount(size_t data_size, u32 num_workers);
+static bool XzCompressSegments(std::span<ByteBuffer> segments, std::span<const u8> data, int clevel, u32 num_workers,
+                               Error* error);
+static std::optional<size_t> XzCompressToStream(std::FILE* fp, std::span<const u8> data, int clevel, u32 num_workers,
+                                                Error* error);
+
+/// Size of the intermediate output buffer used when compressing to a file.
+static constexpr size_t STREAM_CHUNK_SIZE = 128 * 1024;
+
+/// Smallest piece of input that is given its own xz stream/zstd job when compressing with multiple workers.
+static constexpr size_t MIN_XZ_SEGMENT_SIZE = 1024 * 1024;
+static constexpr size_t MIN_ZSTD_JOB_SIZE = 1024 * 1024;
+
+/// Upper bound for GetDefaultWorkerCount(), beyond this the segments get too small to be worth it for our data sizes.
+static constexpr u32 MAX_DEFAULT_WORKER_COUNT = 8;
 
 static std::once_flag s_lzma_crc_table_init;
 
@@ -399,7 +425,7 @@ bool CompressHelpers::XzDecompressor::Decompress(std::span<u8> dst, Error* error
   return true;
 }
 
-bool CompressHelpers::XzCompress(ByteBuffer& ret, const u8* data, size_t data_size, int clevel, Error* error)
+bool CompressHelpers::XzEncode(ISeqOutStream* out_stream, const u8* data, size_t data_size, int clevel, Error* error)
 {
   Init7ZCRCTables();
 
@@ -424,6 +450,22 @@ bool CompressHelpers::XzCompress(ByteBuffer& ret, const u8* data, size_t data_si
                         data_size,
                         0};
 
+  CXzProps props;
+  XzProps_Init(&props);
+  props.lzma2Props.lzmaProps.level = std::clamp(clevel, 1, 9);
+
+  const SRes res = Xz_Encode(out_stream, &mis.vt, &props, nullptr);
+  if (res != SZ_OK)
+  {
+    Error::SetStringFmt(error, "Xz_Encode() failed: {} ({})", SZErrorToString(res), static_cast<int>(res));
+    return false;
+  }
+
+  return true;
+}
+
+bool CompressHelpers::XzCompress(ByteBuffer& ret, const u8* data, size_t data_size, int clevel, Error* error)
+{
   if (ret.empty())
     ret.resize(data_size / 2);
 
@@ -445,21 +487,100 @@ bool CompressHelpers::XzCompress(ByteBuffer& ret, const u8* data, size_t data_si
                        .out_data = &ret,
                        .out_pos = 0};
 
-  CXzProps props;
-  XzProps_Init(&props);
-  props.lzma2Props.lzmaProps.level = std::clamp(clevel, 1, 9);
+  if (!XzEncode(&dos.vt, data, data_size, clevel, error))
+    return false;
 
-  const SRes res = Xz_Encode(&dos.vt, &mis.vt, &props, nullptr);
-  if (res != SZ_OK)
+  ret.resize(dos.out_pos);
+  return true;
+}
+
+size_t CompressHelpers::GetXzSegmentCount(size_t data_size, u32 num_workers)
+{
+  return std::max<size_t>(std::min<size_t>(num_workers, data_size / MIN_XZ_SEGMENT_SIZE), 1);
+}
+
+bool CompressHelpers::XzCompressSegments(std::span<ByteBuffer> segments, std::span<const u8> data, int clevel,
+                                         u32 num_workers, Error* error)
+{
+  // The LZMA SDK is built single-threaded, so split the input and encode each piece as an independent xz stream.
+  // Decoders treat concatenated streams as one file, at the cost of each segment starting with an empty dictionary.
+  const size_t num_segments = segments.size();
+  const size_t segment_size = Common::AlignUpPow2(data.size() / num_segments, 4096);
+  std::vector<Error> segment_errors(num_segments);
+  std::vector<u8> segment_results(num_segments);
+
+  // calling thread picks up tasks while waiting, so it counts as a worker
+  TaskQueue queue;
+  queue.SetWorkerCount(std::min<u32>(num_workers, static_cast<u32>(num_segments)) - 1);
+  for (size_t i = 0; i < num_segments; i++)
   {
-    Error::SetStringFmt(error, "Xz_Encode() failed: {} ({})", SZErrorToString(res), static_cast<int>(res));
-    return false;
+    const size_t offset = std::min(i * segment_size, data.size());
+    const size_t size =
+      (i == (num_segments - 1)) ? (data.size() - offset) : std::min(segment_size, data.size() - offset);
+    queue.SubmitTask([&segments, &segment_errors, &segment_results, i, segment_data = data.subspan(offset, size),
+                      clevel]() {
+      segment_results[i] =
+        XzCompress(segments[i], segment_data.data(), segment_data.size(), clevel, &segment_errors[i]);
+    });
+  }
+  queue.WaitForAll();
+
+  for (size_t i = 0; i < num_segments; i++)
+  {
+    if (!segment_results[i])
+    {
+      Error::SetStringFmt(error, "Segment {} failed: {}", i, segment_errors[i].GetDescription());
+      return false;
+    }
   }
 
-  ret.resize(dos.out_pos);
   return true;
 }
 
+std::optional<size_t> CompressHelpers::XzCompressToStream(std::FILE* fp, std::span<const u8> data, int clevel,
+                                                          u32 num_workers, Error* error)
+{
+  if (const size_t num_segments = GetXzSegmentCount(data.size(), num_workers); num_segments > 1)
+  {
+    std::vector<ByteBuffer> segments(num_segments);
+    if (!XzCompressSegments(segments, data, clevel, num_workers, error))
+      return std::nullopt;
+
+    size_t written = 0;
+    for (const ByteBuffer& segment : segments)
+    {
+      if (!WriteStreamChunk(fp, segment.data(), segment.size(), error))
+        return std::nullopt;
+
+      written += segment.size();
+    }
+
+    return written;
+  }
+
+  // The encoder already produces its output in small pieces, so it can go straight to the file.
+  struct FileOutStream
+  {
+    ISeqOutStream vt;
+    std::FILE* fp;
+    size_t out_pos;
+  };
+  FileOutStream fos = {.vt = {.Write = [](const ISeqOutStream* p, const void* buf, size_t size) -> size_t {
+                         FileOutStream* fos = Z7_CONTAINER_FROM_VTBL(p, FileOutStream, vt);
+                         if (std::fwrite(buf, size, 1, fos->fp) != 1) [[unlikely]]
+                           return 0;
+                         fos->out_pos += size;
+                         return size;
+                       }},
+                       .fp = fp,
+                       .out_pos = 0};
+
+  if (!XzEncode(&fos.vt, data.data(), data.size(), clevel, error))
+    return std::nullopt;
+
+  return fos.out_pos;
+}
+
 std::optional<size_t> CompressHelpers::GetDecompressedSize(CompressType type, std::span<const u8> data,
                                                            Error* error /*= nullptr*/)
 {
@@ -612,7 +733,8 @@ std::optional<size_t> CompressHelpers::DecompressBuffer(std::span<u8> dst, Compr
 }
 
 template<typename T>
-bool CompressHelpers::CompressHelper(ByteBuffer& ret, CompressType type, T data, int clevel, Error* error)
+bool CompressHelpers::CompressHelper(ByteBuffer& ret, CompressType type, T data, int clevel, u32 num_workers,
+                                     Error* error)
 {
   if (data.size() == 0) [[unlikely]]
   {
@@ -664,8 +786,26 @@ bool CompressHelpers::CompressHelper(ByteBuffer& ret, CompressType type, T data,
 
       ret.resize(compressed_size);
 
-      const size_t result = ZSTD_compress(ret.data(), compressed_size, data.data(), data.size(),
-                                          (clevel < 0) ? 0 : std::clamp(clevel, 1, 22));
+      size_t result;
+      if (num_workers > 0)
+      {
+        ZSTD_CCtx* cctx = ZSTD_createCCtx();
+        if (!cctx) [[unlikely]]
+        {
+          Error::SetStringView(error, "ZSTD_createCCtx() failed.");
+          return false;
+        }
+
+        SetZstdCompressParameters(cctx, clevel, num_workers, data.size());
+        result = ZSTD_compress2(cctx, ret.data(), compressed_size, data.data(), data.size());
+        ZSTD_freeCCtx(cctx);
+      }
+      else
+      {
+        result = ZSTD_compress(ret.data(), compressed_size, data.data(), data.size(),
+                               (clevel < 0) ? 0 : std::clamp(clevel, 1, 22));
+      }
+
       if (ZSTD_isError(result)) [[unlikely]]
       {
         const char* errstr = ZSTD_getErrorString(ZSTD_getErrorCode(result));
@@ -679,7 +819,28 @@ bool CompressHelpers::CompressHelper(ByteBuffer& ret, CompressType type, T data,
 
     case CompressType::XZ:
     {
-      return XzCompress(ret, data.data(), data.size(), clevel, error);
+      const size_t num_segments = GetXzSegmentCount(data.size(), num_workers);
+      if (num_segments <= 1)
+        return XzCompress(ret, data.data(), data.size(), clevel, error);
+
+      std::vector<ByteBuffer> segments(num_segments);
+      if (!XzCompressSegments(segments, data, clevel, num_workers, error))
+        return false;
+
+      size_t total_size = 0;
+      for (const ByteBuffer& segment : segments)
+        total_size += segment.size();
+
+      ret.resize(total_size);
+
+      size_t offset = 0;
+      for (const ByteBuffer& segment : segments)
+      {
+        std::memcpy(ret.data() + offset, segment.data(), segment.size());
+        offset += segment.size();
+      }
+
+      return true;
     }
 
       DefaultCaseIsUnreachable()
@@ -767,58 +928,212 @@ CompressHelpers::OptionalByteBuffer CompressHelpers::DecompressFile(CompressType
 }
 
 CompressHelpers::OptionalByteBuffer CompressHelpers::CompressToBuffer(CompressType type, std::span<const u8> data,
-                                                                      int clevel, Error* error)
+                                                                      int clevel, u32 num_workers, Error* error)
 {
   OptionalByteBuffer ret = ByteBuffer();
-  if (!CompressHelper(ret.value(), type, data, clevel, error))
+  if (!CompressHelper(ret.value(), type, data, clevel, num_workers, error))
     ret.reset();
   return ret;
 }
 
 CompressHelpers::OptionalByteBuffer CompressHelpers::CompressToBuffer(CompressType type, const void* data,
-                                                                      size_t data_size, int clevel, Error* error)
+                                                                      size_t data_size, int clevel, u32 num_workers,
+                                                                      Error* error)
 {
   OptionalByteBuffer ret = ByteBuffer();
-  if (!CompressHelper(ret.value(), type, std::span<const u8>(static_cast<const u8*>(data), data_size), clevel, error))
+  if (!CompressHelper(ret.value(), type, std::span<const u8>(static_cast<const u8*>(data), data_size), clevel,
+                      num_workers, error))
+  {
     ret.reset();
+  }
   return ret;
 }
 
 CompressHelpers::OptionalByteBuffer CompressHelpers::CompressToBuffer(CompressType type, OptionalByteBuffer data,
-                                                                      int clevel, Error* error)
+                                                                      int clevel, u32 num_workers, Error* error)
 {
   OptionalByteBuffer ret = ByteBuffer();
-  if (!CompressHelper(ret.value(), type, std::move(data.value()), clevel, error))
+  if (!CompressHelper(ret.value(), type, std::move(data.value()), clevel, num_workers, error))
     ret.reset();
   return ret;
 }
 
 bool CompressHelpers::CompressToBuffer(ByteBuffer& dst, CompressType type, std::span<const u8> data,
-                                       int clevel /*= -1*/, Error* error /*= nullptr*/)
+                                       int clevel /*= -1*/, u32 num_workers /*= 0*/, Error* error /*= nullptr*/)
 {
-  return CompressHelper(dst, type, data, clevel, error);
+  return CompressHelper(dst, type, data, clevel, num_workers, error);
 }
 
 bool CompressHelpers::CompressToBuffer(ByteBuffer& dst, CompressType type, ByteBuffer data, int clevel /*= -1*/,
-                                       Error* error /*= nullptr*/)
+                                       u32 num_workers /*= 0*/, Error* error /*= nullptr*/)
 {
-  return CompressHelper(dst, type, std::move(data), clevel, error);
+  return CompressHelper(dst, type, std::move(data), clevel, num_workers, error);
 }
 
-bool CompressHelpers::CompressToFile(const char* path, std::span<const u8> data, int clevel, bool atomic_write,
-                                     Error* error)
+bool CompressHelpers::WriteStreamChunk(std::FILE* fp, const void* data, size_t size, Error* error)
+{
+  if (std::fwrite(data, size, 1, fp) != 1) [[unlikely]]
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    return false;
+  }
+
+  return true;
+}
+
+std::optional<size_t> CompressHelpers::DeflateCompressToStream(std::FILE* fp, std::span<const u8> data, int clevel,
+                                                               Error* error)
+{
+  z_stream zs = {};
+  int err = deflateInit(&zs, clevel);
+  if (err != Z_OK) [[unlikely]]
+  {
+    Error::SetStringFmt(error, "deflateInit() failed: {} ({})", ZlibErrorToString(err), err);
+    return std::nullopt;
+  }
+
+  const ScopedGuard zs_guard([&zs]() { deflateEnd(&zs); });
+
+  ByteBuffer chunk(STREAM_CHUNK_SIZE);
+  size_t written = 0;
+  zs.next_in = const_cast<Bytef*>(data.data());
+  zs.avail_in = static_cast<uInt>(data.size());
+  do
+  {
+    zs.next_out = chunk.data();
+    zs.avail_out = static_cast<uInt>(chunk.size());
+
+    err = deflate(&zs, Z_FINISH);
+    if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) [[unlikely]]
+    {
+      Error::SetStringFmt(error, "deflate() failed: {} ({})", ZlibErrorToString(err), err);
+      return std::nullopt;
+    }
+
+    const size_t chunk_size = chunk.size() - zs.avail_out;
+    if (chunk_size > 0 && !WriteStreamChunk(fp, chunk.data(), chunk_size, error))
+      return std::nullopt;
+
+    written += chunk_size;
+  } while (err != Z_STREAM_END);
+
+  return written;
+}
+
+void CompressHelpers::SetZstdCompressParameters(ZSTD_CCtx* cctx, int clevel, u32 num_workers, size_t data_size)
+{
+  ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, (clevel < 0) ? 0 : std::clamp(clevel, 1, 22));
+  if (num_workers > 0)
+  {
+    // Fails if the library was built without ZSTD_MULTITHREAD, in which case compression stays on this thread.
+    const size_t res = ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, static_cast<int>(num_workers));
+    if (ZSTD_isError(res)) [[unlikely]]
+    {
+      DEV_LOG("ZSTD_c_nbWorkers not supported, compressing single-threaded.");
+      return;
+    }
+
+    // The default job size scales with the window, which at high levels is larger than an entire save state.
+    // Split the input evenly instead, otherwise only one worker would ever have anything to do.
+    const size_t job_size = std::max(Common::AlignUpPow2(data_size / num_workers, 4096), MIN_ZSTD_JOB_SIZE);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_jobSize, static_cast<int>(std::min<size_t>(job_size, 512 * 1024 * 1024)));
+  }
+}
+
+u32 CompressHelpers::GetDefaultWorkerCount()
+{
+  const u32 hardware_threads = std::thread::hardware_concurrency();
+  return (hardware_threads > 1) ? std::min(hardware_threads - 1, MAX_DEFAULT_WORKER_COUNT) : 0;
+}
+
+std::optional<size_t> CompressHelpers::ZstdCompressToStream(std::FILE* fp, std::span<const u8> data, int clevel,
+                                                            u32 num_workers, Error* error)
+{
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  if (!cctx) [[unlikely]]
+  {
+    Error::SetStringView(error, "ZSTD_createCCtx() failed.");
+    return std::nullopt;
+  }
+
+  const ScopedGuard cctx_guard([cctx]() { ZSTD_freeCCtx(cctx); });
+
+  // Pledging the size puts it in the frame header, same as ZSTD_compress() would.
+  SetZstdCompressParameters(cctx, clevel, num_workers, data.size());
+  ZSTD_CCtx_setPledgedSrcSize(cctx, data.size());
+
+  ByteBuffer chunk(STREAM_CHUNK_SIZE);
+  size_t written = 0;
+  ZSTD_inBuffer in = {data.data(), data.size(), 0};
+  for (;;)
+  {
+    ZSTD_outBuffer out = {chunk.data(), chunk.size(), 0};
+    const size_t remaining = ZSTD_compressStream2(cctx, &out, &in, ZSTD_e_end);
+    if (ZSTD_isError(remaining)) [[unlikely]]
+    {
+      const char* errstr = ZSTD_getErrorString(ZSTD_getErrorCode(remaining));
+      Error::SetStringFmt(error, "ZSTD_compressStream2() failed: {}", errstr ? errstr : "<unknown>");
+      return std::nullopt;
+    }
+
+    if (out.pos > 0 && !WriteStreamChunk(fp, chunk.data(), out.pos, error))
+      return std::nullopt;
+
+    written += out.pos;
+    if (remaining == 0)
+      break;
+  }
+
+  return written;
+}
+
+std::optional<size_t> CompressHelpers::CompressToStream(std::FILE* fp, CompressType type, std::span<const u8> data,
+                                                        int clevel /* = -1 */, u32 num_workers /* = 0 */,
+                                                        Error* error /* = nullptr */)
+{
+  if (data.empty()) [[unlikely]]
+  {
+    Error::SetStringView(error, "Buffer is empty.");
+    return std::nullopt;
+  }
+
+  switch (type)
+  {
+    case CompressType::Uncompressed:
+    {
+      if (!WriteStreamChunk(fp, data.data(), data.size(), error))
+        return std::nullopt;
+
+      return data.size();
+    }
+
+    case CompressType::Deflate:
+      return DeflateCompressToStream(fp, data, clevel, error);
+
+    case CompressType::Zstandard:
+      return ZstdCompressToStream(fp, data, clevel, num_workers, error);
+
+    case CompressType::XZ:
+      return XzCompressToStream(fp, data, clevel, num_workers, error);
+
+      DefaultCaseIsUnreachable()
+  }
+}
+
+bool CompressHelpers::CompressToFile(const char* path, std::span<const u8> data, int clevel, u32 num_workers,
+                                     bool atomic_write, Error* error)
 {
   const std::optional<CompressType> type = GetCompressType(path, error);
   if (!type.has_value())
     return false;
 
-  return CompressToFile(type.value(), path, data, clevel, atomic_write, error);
+  return CompressToFile(type.value(), path, data, clevel, num_workers, atomic_write, error);
 }
 
 bool CompressHelpers::CompressToFile(CompressType type, const char* path, std::span<const u8> data, int clevel,
-                                     bool atomic_write, Error* error)
+                                     u32 num_workers, bool atomic_write, Error* error)
 {
-  const OptionalByteBuffer cdata = CompressToBuffer(type, data, clevel, error);
+  const OptionalByteBuffer cdata = CompressToBuffer(type, data, clevel, num_workers, error);
   if (!cdata.has_value())
     return false;
 
@@ -5,6 +5,7 @@
 
 #include "common/heap_array.h"
 
+#include <cstdio>
 #include <optional>
 #include <span>
 
@@ -41,19 +42,29 @@ OptionalByteBuffer DecompressFile(const char* path, std::optional<size_t> decomp
 OptionalByteBuffer DecompressFile(CompressType type, const char* path,
                                   std::optional<size_t> decompressed_size = std::nullopt, Error* error = nullptr);
 
+// num_workers is the number of threads used for Zstandard/XZ compression, zero compresses on the calling thread.
 OptionalByteBuffer CompressToBuffer(CompressType type, const void* data, size_t data_size, int clevel = -1,
+                                    u32 num_workers = 0, Error* error = nullptr);
+OptionalByteBuffer CompressToBuffer(CompressType type, std::span<const u8> data, int clevel = -1, u32 num_workers = 0,
                                     Error* error = nullptr);
-OptionalByteBuffer CompressToBuffer(CompressType type, std::span<const u8> data, int clevel = -1,
-                                    Error* error = nullptr);
-OptionalByteBuffer CompressToBuffer(CompressType type, OptionalByteBuffer data, int clevel = -1,
+OptionalByteBuffer CompressToBuffer(CompressType type, OptionalByteBuffer data, int clevel = -1, u32 num_workers = 0,
                                     Error* error = nullptr);
 bool CompressToBuffer(ByteBuffer& dst, CompressType type, std::span<const u8> data, int clevel = -1,
+                      u32 num_workers = 0, Error* error = nullptr);
+bool CompressToBuffer(ByteBuffer& dst, CompressType type, ByteBuffer data, int clevel = -1, u32 num_workers = 0,
                       Error* error = nullptr);
-bool CompressToBuffer(ByteBuffer& dst, CompressType type, ByteBuffer data, int clevel = -1, Error* error = nullptr);
-bool CompressToFile(const char* path, std::span<const u8> data, int clevel = -1, bool atomic_write = true,
-                    Error* error = nullptr);
-bool CompressToFile(CompressType type, const char* path, std::span<const u8> data, int clevel = -1,
+bool CompressToFile(const char* path, std::span<const u8> data, int clevel = -1, u32 num_workers = 0,
                     bool atomic_write = true, Error* error = nullptr);
+bool CompressToFile(CompressType type, const char* path, std::span<const u8> data, int clevel = -1,
+                    u32 num_workers = 0, bool atomic_write = true, Error* error = nullptr);
+
+/// Compresses data and writes it to the current position of the file in small chunks, so the compressed data never
+/// has to be held in memory. Returns the number of bytes written.
+std::optional<size_t> CompressToStream(std::FILE* fp, CompressType type, std::span<const u8> data, int clevel = -1,
+                                       u32 num_workers = 0, Error* error = nullptr);
+
+/// Returns a worker count for compressing large buffers, which leaves one hardware thread free for the caller.
+u32 GetDefaultWorkerCount();
 
 const char* SZErrorToString(int res);
 
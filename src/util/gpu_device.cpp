@@ -665,8 +665,8 @@ bool GPUDevice::ClosePipelineCache(const std::string& path, Error* error)
   }
 
   INFO_LOG("Compressing and writing {} bytes to '{}'", data.size(), Path::GetFileName(path));
-  return CompressHelpers::CompressToFile(CompressHelpers::CompressType::Zstandard, path.c_str(), data.cspan(), -1, true,
-                                         error);
+  return CompressHelpers::CompressToFile(CompressHelpers::CompressType::Zstandard, path.c_str(), data.cspan(), -1, 0,
+                                         true, error);
 }
 
 bool GPUDevice::ReadPipelineCache(DynamicHeapArray<u8> data, Error* error)
@@ -297,7 +297,7 @@ bool GPUShaderCache::Insert(const CacheIndexKey& key, const void* data, u32 data
 {
   Error error;
   CompressHelpers::OptionalByteBuffer compress_buffer =
-    CompressHelpers::CompressToBuffer(CompressHelpers::CompressType::Zstandard, data, data_size, -1, &error);
+    CompressHelpers::CompressToBuffer(CompressHelpers::CompressType::Zstandard, data, data_size, -1, 0, &error);
   if (!compress_buffer.has_value()) [[unlikely]]
   {
     ERROR_LOG("Failed to compress shader: {}", error.GetDescription());
@@ -1008,7 +1008,7 @@ void OpenGLDevice::AddToPipelineCache(OpenGLPipeline::ProgramCacheItem* it)
   Error error;
   CompressHelpers::OptionalByteBuffer compressed_data =
     CompressHelpers::CompressToBuffer(CompressHelpers::CompressType::Zstandard,
-                                      CompressHelpers::OptionalByteBuffer(std::move(uncompressed_data)), -1, &error);
+                                      CompressHelpers::OptionalByteBuffer(std::move(uncompressed_data)), -1, 0, &error);
   if (!compressed_data.has_value()) [[unlikely]]
   {
     ERROR_LOG("Failed to compress program: {}", error.GetDescription());